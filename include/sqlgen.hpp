@@ -19,6 +19,7 @@
 #include "sqlgen/Varchar.hpp"
 #include "sqlgen/aggregations.hpp"
 #include "sqlgen/as.hpp"
+#include "sqlgen/batch_size.hpp"
 #include "sqlgen/begin_transaction.hpp"
 #include "sqlgen/cascade.hpp"
 #include "sqlgen/col.hpp"
@@ -39,7 +40,10 @@
 #include "sqlgen/literals.hpp"
 #include "sqlgen/operations.hpp"
 #include "sqlgen/order_by.hpp"
+#include "sqlgen/param.hpp"
 #include "sqlgen/patterns.hpp"
+#include "sqlgen/prefetch.hpp"
+#include "sqlgen/prepare.hpp"
 #include "sqlgen/read.hpp"
 #include "sqlgen/rollback.hpp"
 #include "sqlgen/select_from.hpp"
@@ -1,10 +1,17 @@
 #ifndef SQLGEN_CONNECTIONPOOL_HPP_
 #define SQLGEN_CONNECTIONPOOL_HPP_
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
-#include <memory>
-#include <numeric>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -12,29 +19,172 @@
 #include "Ref.hpp"
 #include "Result.hpp"
 #include "Session.hpp"
+#include "internal/TokenBucket.hpp"
 
 namespace sqlgen {
 
+/// The priority with which a session is acquired from a ConnectionPool.
+/// Waiting threads with a higher priority are served first.
+enum class Priority { high, normal, low };
+
 struct ConnectionPoolConfig {
+  /// The maximum number of connections. Connections are only opened when
+  /// they are needed.
   size_t size = 4;
+
+  /// The number of connections that are opened right away, in parallel,
+  /// and are never evicted for being idle. If not set, all size connections
+  /// are opened right away.
+  std::optional<size_t> min_size = std::nullopt;
+
+  /// Together with wait_time_in_seconds, determines how long .acquire()
+  /// waits for a connection: num_attempts * wait_time_in_seconds seconds.
   size_t num_attempts = 10;
+
   size_t wait_time_in_seconds = 1;
+
+  /// Connections above min_size that have not been used for this long are
+  /// closed. 0 means that connections are never closed for being idle.
+  size_t idle_timeout_in_seconds = 300;
+
+  /// Whether to check that a connection is still alive, before handing it
+  /// out. Dead connections are replaced by new ones.
+  bool validate_on_checkout = true;
+
+  /// The number of shards the idle connections are split into. Every thread
+  /// has a home shard, which it releases connections to and acquires them
+  /// from first. 0 means one shard per hardware thread. Never more than
+  /// size.
+  size_t num_shards = 0;
+
+  /// The number of connections that can only be acquired with
+  /// Priority::high.
+  size_t num_reserved_for_high = 0;
+
+  /// The maximum number of sessions with Priority::low at any point in
+  /// time. 0 means no limit.
+  size_t max_low = 0;
+
+  /// The number of sessions with Priority::low that can be acquired per
+  /// second. 0 means no limit.
+  double low_rate_per_second = 0.0;
+
+  /// The number of sessions with Priority::low that can be acquired in
+  /// quick succession, before low_rate_per_second applies.
+  size_t low_burst = 1;
 };
 
-template <class Connection>
+/// Clock is only meant to be replaced in tests.
+template <class Connection, class Clock = std::chrono::steady_clock>
 class ConnectionPool {
   using ConnPtr = Ref<Connection>;
 
+  /// A connection that is not in use.
+  struct Idle {
+    ConnPtr conn;
+
+    /// When the connection was last released.
+    typename Clock::time_point since;
+  };
+
+  /// A thread that is waiting for a connection.
+  struct Waiter {
+    std::condition_variable cv;
+
+    /// Whether the thread has been served.
+    bool served = false;
+
+    /// The connection handed over to the thread. If the thread has been
+    /// served without a connection, it may open a new one.
+    std::optional<ConnPtr> conn;
+  };
+
+  /// A part of the idle connections. Aligned to the size of a cache line,
+  /// so that threads working on different shards do not contend for the
+  /// same cache line.
+  struct alignas(64) Shard {
+    std::mutex mtx;
+
+    /// The connections that are not in use, the most recently used last.
+    std::vector<Idle> idle;
+  };
+
+  /// The state shared by all copies of the pool and all of its sessions.
+  struct State {
+    State(const ConnectionPoolConfig& _config, const size_t _num_shards)
+        : config(_config),
+          min_size(std::min(_config.min_size.value_or(_config.size),
+                            _config.size)),
+          low_bucket(_config.low_rate_per_second, _config.low_burst),
+          shards(_num_shards) {}
+
+    const ConnectionPoolConfig config;
+
+    /// The number of connections that are never evicted for being idle.
+    const size_t min_size;
+
+    /// Limits the rate at which sessions with Priority::low are acquired.
+    internal::TokenBucket<Clock> low_bucket;
+
+    /// Opens a new connection.
+    std::function<ConnPtr()> connect;
+
+    /// The number of connections that are open or being opened.
+    std::atomic<size_t> num_conns = 0;
+
+    /// The number of sessions that have been admitted and not released.
+    std::atomic<size_t> num_in_use = 0;
+
+    /// The number of sessions with Priority::low that have been admitted
+    /// and not released.
+    std::atomic<size_t> num_low_in_use = 0;
+
+    /// The number of threads in waiters, which can be read without locking
+    /// mtx.
+    std::atomic<size_t> num_waiters = 0;
+
+    std::vector<Shard> shards;
+
+    /// Protects waiters. Shards may be locked while holding mtx, but not
+    /// the other way around.
+    std::mutex mtx;
+
+    /// The threads waiting for a connection, one queue per priority, in
+    /// the order they arrived.
+    std::array<std::deque<Waiter*>, 3> waiters;
+  };
+
  public:
   template <class... Args>
-  ConnectionPool(const ConnectionPoolConfig& _config, const Args&... _args) {
-    conns_->reserve(_config.size);
-    for (size_t i = 0; i < _config.size; ++i) {
-      auto conn = Ref<Connection>::make(_args...);
-      auto flag = Ref<std::atomic_flag>::make();
-      flag->clear();
-      conns_->emplace_back(std::make_pair(std::move(conn), std::move(flag)));
+  ConnectionPool(const ConnectionPoolConfig& _config, const Args&... _args)
+      : state_(Ref<State>::make(_config, num_shards(_config))) {
+    state_->connect = [... args = _args]() {
+      return Ref<Connection>::make(args...);
+    };
+
+    // The initial connections are opened in parallel, so that we do not
+    // pay for the handshakes one after the other.
+    const auto num_initial = state_->min_size;
+    std::vector<std::future<ConnPtr>> futures;
+    for (size_t i = 0; i < num_initial; ++i) {
+      futures.emplace_back(std::async(std::launch::async, state_->connect));
     }
+
+    auto& shards = state_->shards;
+    std::exception_ptr err;
+    for (size_t i = 0; i < futures.size(); ++i) {
+      try {
+        shards[i % shards.size()].idle.emplace_back(
+            Idle{.conn = futures[i].get(), .since = Clock::now()});
+      } catch (...) {
+        err = err ? err : std::current_exception();
+      }
+    }
+    if (err) {
+      std::rethrow_exception(err);
+    }
+
+    state_->num_conns = num_initial;
   }
 
   template <class... Args>
@@ -49,40 +199,360 @@ class ConnectionPool {
 
   ~ConnectionPool() = default;
 
-  /// Acquire a session from the pool. Returns an error if no connections are
-  /// available after several attempts.
-  Result<Ref<Session<Connection>>> acquire() noexcept {
-    for (size_t att = 0; att < config_.num_attempts; ++att) {
-      if (att != 0) {
-        std::this_thread::sleep_for(
-            std::chrono::seconds(config_.wait_time_in_seconds));
+  /// Acquire a session from the pool. Returns an error if no connection
+  /// becomes available within num_attempts * wait_time_in_seconds seconds.
+  Result<Ref<Session<Connection>>> acquire(
+      const Priority _priority = Priority::normal) const noexcept {
+    const auto& config = state_->config;
+    return acquire(std::chrono::seconds(config.num_attempts *
+                                        config.wait_time_in_seconds),
+                   _priority);
+  }
+
+  /// Acquire a session from the pool. If no connection is available, the
+  /// pool has reached its maximum size or _priority is not admitted right
+  /// now, waits for at most _timeout. Waiting threads are served by
+  /// priority and then in the order in which they arrived, as soon as a
+  /// session is released.
+  template <class Rep, class Period>
+  Result<Ref<Session<Connection>>> acquire(
+      const std::chrono::duration<Rep, Period>& _timeout,
+      const Priority _priority = Priority::normal) const noexcept {
+    const auto deadline = Clock::now() + _timeout;
+
+    // Declared before the lock, so the connections are closed after it has
+    // been released.
+    std::vector<Idle> evicted;
+
+    // If there are waiting threads, they come first.
+    if (state_->num_waiters == 0 && admit(state_.get(), _priority)) {
+      if (auto conn = pop_idle(state_.get(), &evicted)) {
+        return checkout(*conn, _priority);
       }
-      for (auto& [conn, flag] : *conns_) {
-        if (!flag->test_and_set()) {
-          return Ref<Session<Connection>>::make(conn, flag);
-        }
+      if (reserve_slot(state_.get())) {
+        return open_connection(_priority);
+      }
+      unadmit(state_.get(), _priority, true);
+    }
+
+    std::unique_lock<std::mutex> lock(state_->mtx);
+
+    auto& queue = state_->waiters[static_cast<size_t>(_priority)];
+
+    Waiter waiter;
+    queue.push_back(&waiter);
+    ++state_->num_waiters;
+
+    while (true) {
+      // A connection might have been released after we last checked, but
+      // before the releasing thread could see us waiting.
+      dispatch(state_.get(), &evicted);
+
+      // Nobody notifies us when the token bucket has been refilled, so we
+      // wake up when the next token is ready. If the bucket is not what we
+      // are waiting for, next_token() returns time_point::max().
+      const auto until =
+          _priority == Priority::low
+              ? std::min(deadline, state_->low_bucket.next_token())
+              : deadline;
+
+      waiter.cv.wait_until(lock, until, [&]() { return waiter.served; });
+
+      if (waiter.served) {
+        break;
+      }
+
+      if (Clock::now() >= deadline) {
+        std::erase(queue, &waiter);
+        --state_->num_waiters;
+        return error("No available connections in the pool.");
       }
     }
-    return error("No available connections in the pool.");
+
+    lock.unlock();
+
+    if (waiter.conn) {
+      return checkout(*waiter.conn, _priority);
+    }
+    return open_connection(_priority);
+  }
+
+  /// Acquire a session from the pool, if a connection is available right
+  /// away. Never waits.
+  Result<Ref<Session<Connection>>> try_acquire(
+      const Priority _priority = Priority::normal) const noexcept {
+    return acquire(std::chrono::microseconds(0), _priority);
   }
 
-  /// Get the current number of available connections
+  /// Get the number of connections that can be acquired without waiting,
+  /// including the ones that have not been opened yet.
   size_t available() const {
-    return std::accumulate(conns_->begin(), conns_->end(), 0,
-                           [](const auto _count, const auto& _p) {
-                             return _p.second->test() ? _count : _count + 1;
-                           });
+    size_t num_idle = 0;
+    for (auto& shard : state_->shards) {
+      std::lock_guard<std::mutex> lock(shard.mtx);
+      num_idle += shard.idle.size();
+    }
+    return num_idle + (state_->config.size - state_->num_conns);
   }
 
-  /// Get the total number of connections in the pool
-  size_t size() const { return conns_->size(); }
+  /// Get the maximum number of connections in the pool
+  size_t size() const { return state_->config.size; }
+
+  /// Get the number of connections that are currently open
+  size_t num_open() const { return state_->num_conns; }
+
+  /// Get the number of threads that are currently waiting for a connection
+  size_t num_waiting() const { return state_->num_waiters; }
 
  private:
-  /// The configuration for the connection pool.
-  ConnectionPoolConfig config_;
+  /// Admits a session with _priority, if the quotas allow it.
+  static bool admit(State* _state, const Priority _priority) {
+    const auto& config = _state->config;
+
+    const auto limit =
+        _priority == Priority::high
+            ? config.size
+            : config.size - std::min(config.num_reserved_for_high, config.size);
+
+    if (!increment_below(&_state->num_in_use, limit)) {
+      return false;
+    }
+
+    if (_priority != Priority::low) {
+      return true;
+    }
+
+    const auto low_limit =
+        config.max_low == 0 ? config.size : config.max_low;
+
+    if (!increment_below(&_state->num_low_in_use, low_limit)) {
+      --_state->num_in_use;
+      return false;
+    }
+
+    if (!_state->low_bucket.try_take()) {
+      --_state->num_low_in_use;
+      --_state->num_in_use;
+      return false;
+    }
+
+    return true;
+  }
+
+  /// Checks whether _conn is still alive and replaces it, if it is not.
+  Result<Ref<Session<Connection>>> checkout(const ConnPtr& _conn,
+                                            const Priority _priority) const {
+    if (!state_->config.validate_on_checkout || is_alive(_conn)) {
+      return make_session(_conn, _priority);
+    }
+    // The slot of the dead connection is reused for the new one.
+    return open_connection(_priority);
+  }
+
+  /// Hands out idle connections and free slots to the waiting threads, by
+  /// priority and then in the order in which they arrived. Must be called
+  /// while holding mtx.
+  static void dispatch(State* _state, std::vector<Idle>* _evicted) {
+    for (size_t p = 0; p < _state->waiters.size(); ++p) {
+      const auto priority = static_cast<Priority>(p);
+      auto& queue = _state->waiters[p];
+      while (!queue.empty()) {
+        // If a priority is not admitted, the lower ones are not admitted
+        // either.
+        if (!admit(_state, priority)) {
+          return;
+        }
+        if (auto conn = pop_idle(_state, _evicted)) {
+          serve_next(_state, &queue, std::move(conn));
+        } else if (reserve_slot(_state)) {
+          serve_next(_state, &queue, std::nullopt);
+        } else {
+          unadmit(_state, priority, true);
+          return;
+        }
+      }
+    }
+  }
 
-  /// The underlying connection objects.
-  Ref<std::vector<std::pair<ConnPtr, Ref<std::atomic_flag>>>> conns_;
+  /// Closes the connections in _shard that have been idle for longer than
+  /// the idle timeout, as long as there are more than min_size. Must be
+  /// called while holding the lock of _shard.
+  static void evict_idle(State* _state, Shard* _shard,
+                         std::vector<Idle>* _evicted) {
+    const auto timeout = _state->config.idle_timeout_in_seconds;
+    if (timeout == 0) {
+      return;
+    }
+    const auto cutoff = Clock::now() - std::chrono::seconds(timeout);
+    auto& idle = _shard->idle;
+    // The least recently used connections are at the front.
+    size_t n = 0;
+    while (n < idle.size() && idle[n].since < cutoff && shrink(_state)) {
+      ++n;
+    }
+    _evicted->insert(_evicted->end(), std::make_move_iterator(idle.begin()),
+                     std::make_move_iterator(idle.begin() + n));
+    idle.erase(idle.begin(), idle.begin() + n);
+  }
+
+  /// The shard the calling thread releases connections to and acquires
+  /// them from first. Threads are assigned to shards round-robin.
+  static size_t home_shard(const State* _state) {
+    static std::atomic<size_t> next_thread = 0;
+    thread_local const size_t thread_ix = next_thread++;
+    return thread_ix % _state->shards.size();
+  }
+
+  static bool is_alive(const ConnPtr& _conn) noexcept {
+    if constexpr (requires { _conn->is_alive(); }) {
+      return _conn->is_alive();
+    } else {
+      return true;
+    }
+  }
+
+  /// Increments _counter, if it is below _limit.
+  static bool increment_below(std::atomic<size_t>* _counter,
+                              const size_t _limit) {
+    auto val = _counter->load();
+    while (val < _limit) {
+      if (_counter->compare_exchange_weak(val, val + 1)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Wraps _conn into a session, which returns it to the pool when it is
+  /// destroyed.
+  Ref<Session<Connection>> make_session(const ConnPtr& _conn,
+                                        const Priority _priority) const {
+    auto state = state_;
+    return Ref<Session<Connection>>::make(_conn, [state, _conn, _priority]() {
+      release(state, _conn, _priority);
+    });
+  }
+
+  static size_t num_shards(const ConnectionPoolConfig& _config) {
+    const size_t n = _config.num_shards != 0
+                         ? _config.num_shards
+                         : std::thread::hardware_concurrency();
+    return std::clamp<size_t>(n, 1, std::max<size_t>(_config.size, 1));
+  }
+
+  /// Opens a new connection. The slot must already have been reserved.
+  Result<Ref<Session<Connection>>> open_connection(
+      const Priority _priority) const {
+    try {
+      return make_session(state_->connect(), _priority);
+    } catch (std::exception& e) {
+      release_slot(state_.get(), _priority);
+      return error(e.what());
+    }
+  }
+
+  /// Takes the most recently used connection from the home shard of the
+  /// calling thread. If that is empty, steals from the other shards.
+  static std::optional<ConnPtr> pop_idle(State* _state,
+                                         std::vector<Idle>* _evicted) {
+    const auto num_shards = _state->shards.size();
+    const auto home = home_shard(_state);
+    for (size_t i = 0; i < num_shards; ++i) {
+      auto& shard = _state->shards[(home + i) % num_shards];
+      std::lock_guard<std::mutex> lock(shard.mtx);
+      evict_idle(_state, &shard, _evicted);
+      if (!shard.idle.empty()) {
+        auto conn = std::move(shard.idle.back().conn);
+        shard.idle.pop_back();
+        return conn;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// Returns the connection to the home shard of the calling thread. If
+  /// there are waiting threads, hands it over to the next one.
+  static void release(const Ref<State>& _state, const ConnPtr& _conn,
+                      const Priority _priority) {
+    {
+      auto& shard = _state->shards[home_shard(_state.get())];
+      std::lock_guard<std::mutex> lock(shard.mtx);
+      shard.idle.emplace_back(Idle{.conn = _conn, .since = Clock::now()});
+    }
+    unadmit(_state.get(), _priority, false);
+    if (_state->num_waiters == 0) {
+      return;
+    }
+    std::vector<Idle> evicted;
+    std::lock_guard<std::mutex> lock(_state->mtx);
+    dispatch(_state.get(), &evicted);
+  }
+
+  /// Called when a connection could not be opened, so that the slot can be
+  /// used by someone else.
+  static void release_slot(State* _state, const Priority _priority) {
+    --_state->num_conns;
+    unadmit(_state, _priority, false);
+    std::vector<Idle> evicted;
+    std::lock_guard<std::mutex> lock(_state->mtx);
+    dispatch(_state, &evicted);
+  }
+
+  /// Reserves a slot for a new connection, if the pool has not reached its
+  /// maximum size.
+  static bool reserve_slot(State* _state) {
+    auto num_conns = _state->num_conns.load();
+    while (num_conns < _state->config.size) {
+      if (_state->num_conns.compare_exchange_weak(num_conns, num_conns + 1)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Serves the thread at the front of _queue. Must be called while holding
+  /// mtx.
+  static void serve_next(State* _state, std::deque<Waiter*>* _queue,
+                         std::optional<ConnPtr>&& _conn) {
+    const auto waiter = _queue->front();
+    _queue->pop_front();
+    --_state->num_waiters;
+    waiter->served = true;
+    waiter->conn = std::move(_conn);
+    // Notifying while holding the lock, because the waiter, which lives on
+    // the stack of the waiting thread, might be gone as soon as we release
+    // it.
+    waiter->cv.notify_one();
+  }
+
+  /// Reverts admit(...). If _unused, the token taken for Priority::low is
+  /// returned to the bucket.
+  static void unadmit(State* _state, const Priority _priority,
+                      const bool _unused) {
+    if (_priority == Priority::low) {
+      --_state->num_low_in_use;
+      if (_unused) {
+        _state->low_bucket.give_back();
+      }
+    }
+    --_state->num_in_use;
+  }
+
+  /// Gives up the slot of an idle connection, if there are more than
+  /// min_size connections.
+  static bool shrink(State* _state) {
+    auto num_conns = _state->num_conns.load();
+    while (num_conns > _state->min_size) {
+      if (_state->num_conns.compare_exchange_weak(num_conns, num_conns - 1)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  /// The state shared by all copies of the pool.
+  Ref<State> state_;
 };
 
 template <class Connection, class... Args>
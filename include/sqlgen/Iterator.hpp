@@ -8,15 +8,21 @@
 #include "IteratorBase.hpp"
 #include "Ref.hpp"
 #include "Result.hpp"
-#include "internal/batch_size.hpp"
+#include "batch_size.hpp"
+#include "internal/BatchSizer.hpp"
+#include "internal/Prefetcher.hpp"
 #include "internal/collect/vector.hpp"
 #include "internal/from_str_vec.hpp"
+#include "internal/to_column_types.hpp"
 
 namespace sqlgen {
 
 /// An input_iterator that returns the underlying type.
 template <class T>
 class Iterator {
+  using BatchType = Ref<std::vector<Result<T>>>;
+  using PrefetcherType = internal::Prefetcher<BatchType>;
+
  public:
   using difference_type = std::ptrdiff_t;
   using value_type = Result<T>;
@@ -31,8 +37,23 @@ class Iterator {
     }
   };
 
-  Iterator(const Ref<IteratorBase>& _it)
-      : current_batch_(get_next_batch(_it)), it_(_it), ix_(0) {}
+  /// If _prefetch is greater than 0, up to _prefetch batches are fetched and
+  /// decoded on a worker thread while the current batch is being consumed.
+  Iterator(const Ref<IteratorBase>& _it,
+           const BatchSize& _batch_size = BatchSize{},
+           const size_t _prefetch = 0)
+      : it_(_it),
+        ix_(0),
+        sizer_(Ref<internal::BatchSizer>::make(_batch_size)) {
+    it_->set_column_types(internal::to_column_types<T>());
+    if (_prefetch != 0) {
+      const auto fetch = [sizer = sizer_](const Ref<IteratorBase>& _it) {
+        return get_next_batch(_it, sizer.get());
+      };
+      prefetcher_ = std::make_shared<PrefetcherType>(it_, _prefetch, fetch);
+    }
+    current_batch_ = next_batch();
+  }
 
   ~Iterator() = default;
 
@@ -48,8 +69,8 @@ class Iterator {
 
   Iterator<T>& operator++() noexcept {
     ++ix_;
-    if (ix_ >= current_batch_->size() && !it_->end()) {
-      current_batch_ = get_next_batch(it_);
+    if (ix_ >= current_batch_->size() && (prefetcher_ || !it_->end())) {
+      current_batch_ = next_batch();
       ix_ = 0;
     }
     return *this;
@@ -58,26 +79,44 @@ class Iterator {
   void operator++(int) noexcept { ++*this; }
 
  private:
-  static Ref<std::vector<Result<T>>> get_next_batch(
-      const Ref<IteratorBase>& _it) noexcept {
-    using namespace std::ranges::views;
-    return _it->next(SQLGEN_BATCH_SIZE)
-        .transform([](auto str_vec) {
-          return Ref<std::vector<Result<T>>>::make(internal::collect::vector(
-              str_vec | transform(internal::from_str_vec<T>)));
+  static BatchType get_next_batch(const Ref<IteratorBase>& _it,
+                                  internal::BatchSizer* _sizer) noexcept {
+    return _it->next(_sizer->next())
+        .transform([&](const auto& _batch) {
+          _sizer->update(_batch);
+          auto results = Ref<std::vector<Result<T>>>::make();
+          results->reserve(_batch.size());
+          for (size_t i = 0; i < _batch.size(); ++i) {
+            results->emplace_back(internal::from_str_vec<T>(_batch[i]));
+          }
+          return results;
         })
-        .value_or(Ref<std::vector<Result<T>>>());
+        .value_or(BatchType());
+  }
+
+  BatchType next_batch() noexcept {
+    if (prefetcher_) {
+      return prefetcher_->pop().value_or(BatchType());
+    }
+    return get_next_batch(it_, sizer_.get());
   }
 
  private:
   /// The current batch of data.
-  Ref<std::vector<Result<T>>> current_batch_;
+  BatchType current_batch_;
 
   /// The underlying database iterator.
   Ref<IteratorBase> it_;
 
   /// The current index in the current batch.
   size_t ix_;
+
+  /// Determines the number of rows in the next batch.
+  Ref<internal::BatchSizer> sizer_;
+
+  /// Fetches the next batches in the background, if prefetching is enabled.
+  /// Shared between copies of the iterator.
+  std::shared_ptr<PrefetcherType> prefetcher_;
 };
 
 }  // namespace sqlgen
@@ -1,11 +1,12 @@
 #ifndef SQLGEN_ITERATORBASE_HPP_
 #define SQLGEN_ITERATORBASE_HPP_
 
-#include <optional>
-#include <string>
+#include <cstddef>
 #include <vector>
 
 #include "Result.hpp"
+#include "RowBatch.hpp"
+#include "dynamic/Type.hpp"
 
 namespace sqlgen {
 
@@ -19,8 +20,12 @@ struct IteratorBase {
   /// Returns the next batch of rows.
   /// If _batch_size is greater than the number of rows left, returns all
   /// of the rows left.
-  virtual Result<std::vector<std::vector<std::optional<std::string>>>> next(
-      const size_t _batch_size) = 0;
+  virtual Result<RowBatch> next(const size_t _batch_size) = 0;
+
+  /// Passes the types of the fields the rows are going to be parsed into.
+  /// Backends can use these hints to extract values natively rather than as
+  /// text. They are ignored by default.
+  virtual void set_column_types(const std::vector<dynamic::Type>&) {}
 };
 
 }  // namespace sqlgen
@@ -6,6 +6,7 @@
 
 #include "Iterator.hpp"
 #include "Result.hpp"
+#include "batch_size.hpp"
 
 namespace sqlgen {
 
@@ -21,17 +22,26 @@ class Range {
 
   struct End {};
 
-  Range(const Ref<IteratorBase>& _it) : it_(_it) {}
+  Range(const Ref<IteratorBase>& _it,
+        const BatchSize& _batch_size = BatchSize{},
+        const size_t _prefetch = 0)
+      : it_(_it), batch_size_(_batch_size), prefetch_(_prefetch) {}
 
   ~Range() = default;
 
-  auto begin() const { return Iterator<T>(it_); }
+  auto begin() const { return Iterator<T>(it_, batch_size_, prefetch_); }
 
   auto end() const { return typename Iterator<T>::End{}; }
 
  private:
   /// The underlying database iterator.
   Ref<IteratorBase> it_;
+
+  /// Determines how many rows are fetched at once.
+  BatchSize batch_size_;
+
+  /// The number of batches to fetch in the background, 0 if disabled.
+  size_t prefetch_;
 };
 
 }  // namespace sqlgen
@@ -0,0 +1,262 @@
+#ifndef SQLGEN_ROWBATCH_HPP_
+#define SQLGEN_ROWBATCH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace sqlgen {
+
+/// A batch of rows, as returned by IteratorBase::next(...).
+///
+/// All bytes of all cells are kept in a single contiguous arena, so filling a
+/// batch does not require a heap allocation per cell. For every column, we
+/// keep track of the offsets and lengths of its cells within the arena, as
+/// well as the kind of value they hold. Every text value is followed by a
+/// '\0' in the arena, so the views can also be passed to C APIs that expect
+/// NUL-terminated strings.
+class RowBatch {
+ public:
+  /// A non-owning view on a single cell of the batch. Apart from NULL and
+  /// text, a cell can hold a native value, which the backend was able to
+  /// extract without formatting it as text first.
+  class Cell {
+   public:
+    enum class Kind : std::uint8_t {
+      null_value,
+      text,
+      int64,
+      float64,
+      timestamp
+    };
+
+    Cell(const Kind _kind, const char* _ptr, const size_t _len)
+        : kind_(_kind), ptr_(_ptr), len_(_len) {}
+
+    /// The native floating point value of the cell.
+    double float64() const noexcept {
+      double val = 0.0;
+      std::memcpy(&val, ptr_, sizeof(val));
+      return val;
+    }
+
+    /// The native integer value of the cell.
+    std::int64_t int64() const noexcept {
+      std::int64_t val = 0;
+      std::memcpy(&val, ptr_, sizeof(val));
+      return val;
+    }
+
+    /// Whether the cell holds a native value.
+    bool is_native() const noexcept {
+      return kind_ == Kind::int64 || kind_ == Kind::float64 ||
+             kind_ == Kind::timestamp;
+    }
+
+    /// Whether the cell is NULL.
+    bool is_null() const noexcept { return kind_ == Kind::null_value; }
+
+    /// The kind of value held by the cell.
+    Kind kind() const noexcept { return kind_; }
+
+    /// The text value of the cell.
+    std::string_view text() const noexcept {
+      return std::string_view(ptr_, len_);
+    }
+
+    /// The native timestamp value of the cell, in microseconds since the
+    /// Unix epoch (UTC).
+    std::int64_t timestamp() const noexcept { return int64(); }
+
+   private:
+    /// The kind of value held by the cell.
+    Kind kind_;
+
+    /// Points to the bytes of the cell within the arena.
+    const char* ptr_;
+
+    /// The number of bytes of the cell.
+    size_t len_;
+  };
+
+  /// A non-owning view on a single row of the batch.
+  class Row {
+   public:
+    Row(const RowBatch* _batch, const size_t _i) : batch_(_batch), i_(_i) {}
+
+    /// Returns the cell in column _j.
+    Cell operator[](const size_t _j) const noexcept {
+      return batch_->get(i_, _j);
+    }
+
+    /// The number of columns in the row.
+    size_t size() const { return batch_->num_cols(); }
+
+   private:
+    /// The batch the row belongs to.
+    const RowBatch* batch_;
+
+    /// The index of the row within the batch.
+    size_t i_;
+  };
+
+  RowBatch(const size_t _num_cols = 0)
+      : cols_(_num_cols), col_ix_(0), num_rows_(0) {}
+
+  ~RowBatch() = default;
+
+  /// Removes all rows, but keeps the allocated memory, so the batch can be
+  /// reused.
+  void clear() noexcept {
+    arena_.clear();
+    for (auto& col : cols_) {
+      col.offsets.clear();
+      col.lengths.clear();
+      col.kinds.clear();
+    }
+    col_ix_ = 0;
+    num_rows_ = 0;
+  }
+
+  /// Whether there are no complete rows in the batch.
+  bool empty() const noexcept { return num_rows_ == 0; }
+
+  /// Returns the cell in row _i and column _j.
+  Cell get(const size_t _i, const size_t _j) const noexcept {
+    const auto& col = cols_[_j];
+    return Cell(col.kinds[_i], arena_.data() + col.offsets[_i],
+                col.lengths[_i]);
+  }
+
+  /// The number of columns in the batch.
+  size_t num_cols() const noexcept { return cols_.size(); }
+
+  /// The number of bytes currently held by the arena.
+  size_t num_bytes() const noexcept { return arena_.size(); }
+
+  /// The number of complete rows in the batch.
+  size_t num_rows() const noexcept { return num_rows_; }
+
+  /// Returns a view on row _i.
+  Row operator[](const size_t _i) const noexcept { return Row(this, _i); }
+
+  /// Appends a value to the current row. The row is complete once a value
+  /// has been appended for every column.
+  void push_back(const std::string_view _val) {
+    auto& col = cols_[col_ix_];
+    col.offsets.push_back(arena_.size());
+    col.lengths.push_back(_val.size());
+    col.kinds.push_back(Cell::Kind::text);
+    arena_.insert(arena_.end(), _val.begin(), _val.end());
+    arena_.push_back('\0');
+    next_col();
+  }
+
+  /// Appends a copy of _cell, which may belong to another batch, to the
+  /// current row.
+  void push_cell(const Cell& _cell) {
+    switch (_cell.kind()) {
+      case Cell::Kind::null_value:
+        push_null();
+        break;
+
+      case Cell::Kind::text:
+        push_back(_cell.text());
+        break;
+
+      case Cell::Kind::int64:
+        push_int64(_cell.int64());
+        break;
+
+      case Cell::Kind::float64:
+        push_float64(_cell.float64());
+        break;
+
+      case Cell::Kind::timestamp:
+        push_timestamp(_cell.timestamp());
+        break;
+    }
+  }
+
+  /// Appends a native floating point value to the current row.
+  void push_float64(const double _val) {
+    push_native(Cell::Kind::float64, &_val, sizeof(_val));
+  }
+
+  /// Appends a native integer value to the current row.
+  void push_int64(const std::int64_t _val) {
+    push_native(Cell::Kind::int64, &_val, sizeof(_val));
+  }
+
+  /// Appends a native timestamp to the current row, in microseconds since
+  /// the Unix epoch (UTC).
+  void push_timestamp(const std::int64_t _microseconds) {
+    push_native(Cell::Kind::timestamp, &_microseconds, sizeof(_microseconds));
+  }
+
+  /// Appends a NULL value to the current row.
+  void push_null() {
+    auto& col = cols_[col_ix_];
+    col.offsets.push_back(arena_.size());
+    col.lengths.push_back(0);
+    col.kinds.push_back(Cell::Kind::null_value);
+    next_col();
+  }
+
+  /// Reserves memory for _num_rows rows and _num_bytes bytes in the arena.
+  void reserve(const size_t _num_rows, const size_t _num_bytes = 0) {
+    arena_.reserve(_num_bytes);
+    for (auto& col : cols_) {
+      col.offsets.reserve(_num_rows);
+      col.lengths.reserve(_num_rows);
+      col.kinds.reserve(_num_rows);
+    }
+  }
+
+  /// The number of complete rows in the batch.
+  size_t size() const noexcept { return num_rows_; }
+
+ private:
+  struct Column {
+    std::vector<size_t> offsets;
+    std::vector<size_t> lengths;
+    std::vector<Cell::Kind> kinds;
+  };
+
+  void next_col() noexcept {
+    if (++col_ix_ == cols_.size()) {
+      col_ix_ = 0;
+      ++num_rows_;
+    }
+  }
+
+  void push_native(const Cell::Kind _kind, const void* _ptr,
+                   const size_t _size) {
+    auto& col = cols_[col_ix_];
+    col.offsets.push_back(arena_.size());
+    col.lengths.push_back(_size);
+    col.kinds.push_back(_kind);
+    const auto bytes = static_cast<const char*>(_ptr);
+    arena_.insert(arena_.end(), bytes, bytes + _size);
+    next_col();
+  }
+
+ private:
+  /// Contains the bytes of all cells in the batch.
+  std::vector<char> arena_;
+
+  /// Keeps track of where the cells of each column are located.
+  std::vector<Column> cols_;
+
+  /// The column the next value will be appended to.
+  size_t col_ix_;
+
+  /// The number of complete rows.
+  size_t num_rows_;
+};
+
+}  // namespace sqlgen
+
+#endif
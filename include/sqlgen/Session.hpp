@@ -1,13 +1,14 @@
 #ifndef SQLGEN_SESSION_HPP_
 #define SQLGEN_SESSION_HPP_
 
-#include <atomic>
-#include <memory>
+#include <functional>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "IteratorBase.hpp"
 #include "Ref.hpp"
+#include "RowBatch.hpp"
 #include "dynamic/Insert.hpp"
 #include "dynamic/SelectFrom.hpp"
 #include "dynamic/Statement.hpp"
@@ -20,19 +21,22 @@ class Session {
  public:
   using ConnPtr = Ref<Connection>;
 
-  Session(const Ref<Connection>& _conn, const Ref<std::atomic_flag>& _flag)
-      : conn_(_conn), flag_(_flag.ptr()) {}
+  /// Returns the connection to wherever it came from.
+  using ReleaseFunction = std::function<void()>;
+
+  Session(const Ref<Connection>& _conn, const ReleaseFunction& _release)
+      : conn_(_conn), release_(_release) {}
 
   Session(const Session<Connection>& _other) = delete;
 
   Session(Session<Connection>&& _other)
-      : conn_(std::move(_other.conn_)), flag_(_other.flag_) {
-    _other.flag_.reset();
+      : conn_(std::move(_other.conn_)), release_(std::move(_other.release_)) {
+    _other.release_ = nullptr;
   }
 
   ~Session() {
-    if (flag_) {
-      flag_->clear();
+    if (release_) {
+      release_();
     }
   }
 
@@ -44,9 +48,13 @@ class Session {
     return conn_->execute(_sql);
   }
 
-  Result<Nothing> insert(
-      const dynamic::Insert& _stmt,
-      const std::vector<std::vector<std::optional<std::string>>>& _data) {
+  Result<Nothing> execute(const std::string& _sql,
+                          const RowBatch& _params) {
+    return conn_->execute(_sql, _params);
+  }
+
+  Result<Nothing> insert(const dynamic::Insert& _stmt,
+                         const RowBatch& _data) {
     return conn_->insert(_stmt, _data);
   }
 
@@ -56,9 +64,12 @@ class Session {
     if (this == &_other) {
       return *this;
     }
+    if (release_) {
+      release_();
+    }
     conn_ = std::move(_other.conn_);
-    flag_ = _other.flag_;
-    _other.flag_.reset();
+    release_ = std::move(_other.release_);
+    _other.release_ = nullptr;
     return *this;
   }
 
@@ -66,6 +77,11 @@ class Session {
     return conn_->read(_query);
   }
 
+  Result<Ref<IteratorBase>> read(const std::string& _sql,
+                                 const RowBatch& _params) {
+    return conn_->read(_sql, _params);
+  }
+
   Result<Nothing> rollback() noexcept { return conn_->rollback(); }
 
   std::string to_sql(const dynamic::Statement& _stmt) noexcept {
@@ -78,8 +94,7 @@ class Session {
 
   Result<Nothing> end_write() { return conn_->end_write(); }
 
-  Result<Nothing> write(
-      const std::vector<std::vector<std::optional<std::string>>>& _data) {
+  Result<Nothing> write(const RowBatch& _data) {
     return conn_->write(_data);
   }
 
@@ -87,9 +102,9 @@ class Session {
   /// The underlying connection object.
   ConnPtr conn_;
 
-  /// The flag corresponding to the object - as long as this is true, we have
-  /// ownership.
-  std::shared_ptr<std::atomic_flag> flag_;
+  /// Called when the session is destroyed - as long as this is set, we have
+  /// ownership of the connection.
+  ReleaseFunction release_;
 };
 
 }  // namespace sqlgen
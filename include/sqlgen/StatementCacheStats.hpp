@@ -0,0 +1,25 @@
+#ifndef SQLGEN_STATEMENTCACHESTATS_HPP_
+#define SQLGEN_STATEMENTCACHESTATS_HPP_
+
+#include <cstddef>
+
+namespace sqlgen {
+
+/// Describes the state of the prepared statement cache of a connection.
+struct StatementCacheStats {
+  /// The maximum number of statements kept in the cache.
+  size_t capacity = 0;
+
+  /// The number of times a statement was found in the cache.
+  size_t hits = 0;
+
+  /// The number of times a statement had to be prepared.
+  size_t misses = 0;
+
+  /// The number of statements currently in the cache.
+  size_t size = 0;
+};
+
+}  // namespace sqlgen
+
+#endif
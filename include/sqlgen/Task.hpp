@@ -0,0 +1,134 @@
+#ifndef SQLGEN_TASK_HPP_
+#define SQLGEN_TASK_HPP_
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace sqlgen {
+
+/// A lazily started coroutine returning a T, as returned by asynchronous
+/// connections. It starts running when it is awaited, or when an event loop
+/// calls .start(). When it has finished, it resumes the coroutine awaiting
+/// it.
+template <class T>
+class Task {
+ public:
+  struct promise_type;
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  /// Resumes the coroutine awaiting the task, once it has finished.
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(Handle _handle) const noexcept {
+      return _handle.promise().continuation;
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  struct promise_type {
+    /// The coroutine awaiting the task, if any.
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+
+    std::exception_ptr exception;
+
+    std::optional<T> value;
+
+    Task get_return_object() noexcept {
+      return Task(Handle::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    template <class U>
+    void return_value(U&& _value) {
+      value.emplace(std::forward<U>(_value));
+    }
+
+    void unhandled_exception() noexcept {
+      exception = std::current_exception();
+    }
+  };
+
+  /// Starts the task when it is awaited and resumes the awaiting coroutine
+  /// when it has finished.
+  struct Awaiter {
+    bool await_ready() const noexcept { return handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(
+        const std::coroutine_handle<> _continuation) const noexcept {
+      handle_.promise().continuation = _continuation;
+      return handle_;
+    }
+
+    T await_resume() const { return take(handle_); }
+
+    Handle handle_;
+  };
+
+  Task(Task&& _other) noexcept
+      : handle_(std::exchange(_other.handle_, nullptr)) {}
+
+  Task(const Task& _other) = delete;
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  /// Whether the task has finished.
+  bool done() const noexcept { return handle_.done(); }
+
+  /// The exception thrown by a task that has finished, if any.
+  std::exception_ptr exception() const noexcept {
+    return handle_.promise().exception;
+  }
+
+  /// Runs the task until it first suspends. Used by event loops to start
+  /// the outermost task.
+  void start() const { handle_.resume(); }
+
+  /// The result of a task that has finished.
+  T result() const { return take(handle_); }
+
+  Awaiter operator co_await() const& noexcept { return Awaiter{handle_}; }
+
+  Awaiter operator co_await() const&& noexcept { return Awaiter{handle_}; }
+
+  Task& operator=(Task&& _other) noexcept {
+    if (this != &_other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(_other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  Task& operator=(const Task& _other) = delete;
+
+ private:
+  explicit Task(const Handle _handle) : handle_(_handle) {}
+
+  static T take(const Handle _handle) {
+    auto& promise = _handle.promise();
+    if (promise.exception) {
+      std::rethrow_exception(promise.exception);
+    }
+    return std::move(*promise.value);
+  }
+
+ private:
+  Handle handle_;
+};
+
+}  // namespace sqlgen
+
+#endif
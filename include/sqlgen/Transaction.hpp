@@ -2,6 +2,7 @@
 #define SQLGEN_TRANSACTION_HPP_
 
 #include "Ref.hpp"
+#include "RowBatch.hpp"
 #include "is_connection.hpp"
 
 namespace sqlgen {
@@ -55,9 +56,13 @@ class Transaction {
     return conn_->execute(_sql);
   }
 
-  Result<Nothing> insert(
-      const dynamic::Insert& _stmt,
-      const std::vector<std::vector<std::optional<std::string>>>& _data) {
+  Result<Nothing> execute(const std::string& _sql,
+                          const RowBatch& _params) {
+    return conn_->execute(_sql, _params);
+  }
+
+  Result<Nothing> insert(const dynamic::Insert& _stmt,
+                         const RowBatch& _data) {
     return conn_->insert(_stmt, _data);
   }
 
@@ -77,6 +82,11 @@ class Transaction {
     return conn_->read(_query);
   }
 
+  Result<Ref<IteratorBase>> read(const std::string& _sql,
+                                 const RowBatch& _params) {
+    return conn_->read(_sql, _params);
+  }
+
   Result<Nothing> rollback() noexcept {
     if (transaction_ended_) {
       return error("Transaction has already ended, cannot roll back.");
@@ -97,8 +107,7 @@ class Transaction {
 
   Result<Nothing> end_write() { return conn_->end_write(); }
 
-  Result<Nothing> write(
-      const std::vector<std::vector<std::optional<std::string>>>& _data) {
+  Result<Nothing> write(const RowBatch& _data) {
     return conn_->write(_data);
   }
 
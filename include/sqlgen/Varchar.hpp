@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "Result.hpp"
 
@@ -19,6 +20,8 @@ class Varchar {
 
   Varchar(const std::string& _value) : value_(check_size(_value)) {}
 
+  Varchar(std::string&& _value) : value_(check_size(std::move(_value))) {}
+
   Varchar(const char* _value) : value_(check_size(_value)) {}
 
   Varchar(Varchar<_size>&& _other) noexcept = default;
@@ -91,6 +94,15 @@ class Varchar {
     return _str;
   }
 
+  static std::string check_size(std::string&& _str) {
+    if (_str.size() > size_) {
+      throw std::runtime_error(
+          "String '" + _str + "' too long: " + std::to_string(_str.size()) +
+          " exceeds the maximum length of " + std::to_string(size_) + ".");
+    }
+    return std::move(_str);
+  }
+
  private:
   /// The underlying value.
   std::string value_;
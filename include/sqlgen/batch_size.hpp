@@ -0,0 +1,42 @@
+#ifndef SQLGEN_BATCH_SIZE_HPP_
+#define SQLGEN_BATCH_SIZE_HPP_
+
+#include <cstddef>
+
+#include "internal/batch_size.hpp"
+
+namespace sqlgen {
+
+/// Determines how many rows are fetched from the database at once.
+struct BatchSize {
+  /// The number of rows in the first batch.
+  size_t initial_rows = SQLGEN_BATCH_SIZE;
+
+  /// The maximum number of rows in a batch.
+  size_t max_rows = SQLGEN_BATCH_SIZE;
+
+  /// If greater than 0, the batch size doubles after every batch, as long
+  /// as the next batch is expected to take up no more than max_bytes,
+  /// judging by the rows seen so far.
+  size_t max_bytes = 0;
+};
+
+/// Fetches _rows rows at once.
+inline auto batch_size(const size_t _rows) {
+  return BatchSize{.initial_rows = _rows, .max_rows = _rows};
+}
+
+/// Starts with _initial_rows rows and doubles the batch size after every
+/// batch, until it reaches _max_rows or the next batch is expected to take
+/// up more than _max_bytes.
+inline auto adaptive_batch_size(const size_t _max_bytes,
+                                const size_t _initial_rows = 100,
+                                const size_t _max_rows = SQLGEN_BATCH_SIZE) {
+  return BatchSize{.initial_rows = _initial_rows,
+                   .max_rows = _max_rows,
+                   .max_bytes = _max_bytes};
+}
+
+}  // namespace sqlgen
+
+#endif
@@ -1,25 +1,42 @@
 #ifndef SQLGEN_DELETE_FROM_HPP_
 #define SQLGEN_DELETE_FROM_HPP_
 
+#include <string>
 #include <type_traits>
 
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "Task.hpp"
+#include "dynamic/Arena.hpp"
+#include "is_async_connection.hpp"
 #include "is_connection.hpp"
 #include "transpilation/to_delete_from.hpp"
 #include "where.hpp"
 
 namespace sqlgen {
 
+/// Generates the DELETE statement. Without a WHERE clause, it only depends
+/// on the types, so the SQL is generated once per connection type.
+template <class ValueType, class WhereType, class Connection>
+std::string delete_from_sql(const Ref<Connection>& _conn,
+                            const WhereType& _where) {
+  if constexpr (std::is_same_v<WhereType, Nothing>) {
+    static const auto sql = _conn->to_sql(
+        transpilation::to_delete_from<ValueType, WhereType>(_where));
+    return sql;
+  } else {
+    dynamic::Arena arena;
+    return _conn->to_sql(
+        transpilation::to_delete_from<ValueType, WhereType>(_where));
+  }
+}
+
 template <class ValueType, class WhereType, class Connection>
   requires is_connection<Connection>
 Result<Ref<Connection>> delete_from_impl(const Ref<Connection>& _conn,
                                          const WhereType& _where) {
-  const auto query =
-      transpilation::to_delete_from<ValueType, WhereType>(_where);
-  return _conn->execute(_conn->to_sql(query)).transform([&](const auto&) {
-    return _conn;
-  });
+  return _conn->execute(delete_from_sql<ValueType>(_conn, _where))
+      .transform([&](const auto&) { return _conn; });
 }
 
 template <class ValueType, class WhereType, class Connection>
@@ -31,6 +48,13 @@ Result<Ref<Connection>> delete_from_impl(const Result<Ref<Connection>>& _res,
   });
 }
 
+template <class ValueType, class WhereType, class Connection>
+  requires is_async_connection<Connection>
+Task<Result<Ref<Connection>>> delete_from_impl(const Ref<Connection>& _conn,
+                                               const WhereType& _where) {
+  return execute_async(_conn, delete_from_sql<ValueType>(_conn, _where));
+}
+
 template <class ValueType, class WhereType = Nothing>
 struct DeleteFrom {
   auto operator()(const auto& _conn) const {
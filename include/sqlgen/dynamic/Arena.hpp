@@ -0,0 +1,86 @@
+#ifndef SQLGEN_DYNAMIC_ARENA_HPP_
+#define SQLGEN_DYNAMIC_ARENA_HPP_
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sqlgen::dynamic {
+
+/// A monotonic arena for the nodes of a statement tree. While an arena is
+/// alive, it is the current arena of its thread and NodeRef<T>::make(...)
+/// allocates all nodes in it. The nodes are released all at once, when the
+/// arena is destroyed, so the arena must outlive the tree built in it.
+class Arena {
+  /// The number of bytes that are allocated inside the arena itself,
+  /// before falling back to the heap.
+  static constexpr size_t initial_size_ = 4096;
+
+  struct Destructor {
+    void* ptr;
+    void (*destroy)(void*);
+  };
+
+ public:
+  Arena()
+      : resource_(buffer_.data(), buffer_.size()),
+        destructors_(&resource_),
+        prev_(current_) {
+    current_ = this;
+  }
+
+  Arena(const Arena&) = delete;
+
+  Arena(Arena&&) = delete;
+
+  ~Arena() {
+    for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+      it->destroy(it->ptr);
+    }
+    current_ = prev_;
+  }
+
+  Arena& operator=(const Arena&) = delete;
+
+  Arena& operator=(Arena&&) = delete;
+
+  /// The arena nodes are currently allocated in, nullptr if there is none.
+  static Arena* current() noexcept { return current_; }
+
+  /// Constructs a T inside the arena.
+  template <class T, class... Args>
+  T* make(Args&&... _args) {
+    const auto ptr = new (resource_.allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(_args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      destructors_.push_back(Destructor{
+          .ptr = ptr, .destroy = [](void* _p) { static_cast<T*>(_p)->~T(); }});
+    }
+    return ptr;
+  }
+
+ private:
+  /// The first bytes of the arena, so that small trees do not require any
+  /// heap allocation.
+  alignas(std::max_align_t) std::array<std::byte, initial_size_> buffer_;
+
+  /// Hands out the memory, which is only released as a whole.
+  std::pmr::monotonic_buffer_resource resource_;
+
+  /// The destructors of the nodes, which are called in reverse order.
+  std::pmr::vector<Destructor> destructors_;
+
+  /// The arena that was current before this one.
+  Arena* prev_;
+
+  /// The current arena of this thread.
+  inline static thread_local Arena* current_ = nullptr;
+};
+
+}  // namespace sqlgen::dynamic
+
+#endif
@@ -3,17 +3,17 @@
 
 #include <rfl.hpp>
 
-#include "../Ref.hpp"
 #include "Column.hpp"
 #include "ColumnOrValue.hpp"
+#include "NodeRef.hpp"
 #include "Operation.hpp"
 
 namespace sqlgen::dynamic {
 
 struct Condition {
   struct And {
-    Ref<Condition> cond1;
-    Ref<Condition> cond2;
+    NodeRef<Condition> cond1;
+    NodeRef<Condition> cond2;
   };
 
   struct Equal {
@@ -55,7 +55,7 @@ struct Condition {
   };
 
   struct Not {
-    Ref<Condition> cond;
+    NodeRef<Condition> cond;
   };
 
   struct NotEqual {
@@ -69,8 +69,8 @@ struct Condition {
   };
 
   struct Or {
-    Ref<Condition> cond1;
-    Ref<Condition> cond2;
+    NodeRef<Condition> cond1;
+    NodeRef<Condition> cond2;
   };
 
   using ReflectionType =
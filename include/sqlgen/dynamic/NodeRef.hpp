@@ -0,0 +1,60 @@
+#ifndef SQLGEN_DYNAMIC_NODEREF_HPP_
+#define SQLGEN_DYNAMIC_NODEREF_HPP_
+
+#include <memory>
+#include <utility>
+
+#include "Arena.hpp"
+
+namespace sqlgen::dynamic {
+
+/// A reference to a node in a statement tree, which is never null. Nodes
+/// created while there is a current Arena live in that arena and the
+/// reference does not own them, so copying it is as cheap as copying a
+/// pointer. All other nodes live on the heap and are shared, like Ref<T>.
+template <class T>
+class NodeRef {
+ public:
+  using ReflectionType = T;
+
+  explicit NodeRef(const T& _t) : NodeRef(make(_t)) {}
+
+  explicit NodeRef(T&& _t) : NodeRef(make(std::move(_t))) {}
+
+  template <class... Args>
+  static NodeRef make(Args&&... _args) {
+    if (const auto arena = Arena::current()) {
+      return NodeRef(arena->make<T>(std::forward<Args>(_args)...), nullptr);
+    }
+    auto owner = std::make_shared<T>(std::forward<Args>(_args)...);
+    const auto ptr = owner.get();
+    return NodeRef(ptr, std::move(owner));
+  }
+
+  T* get() const noexcept { return ptr_; }
+
+  /// Whether the node lives on the heap, rather than in an arena.
+  bool is_owning() const noexcept { return owner_ != nullptr; }
+
+  T& operator*() const noexcept { return *ptr_; }
+
+  T* operator->() const noexcept { return ptr_; }
+
+  /// Needed for the serialization.
+  const T& reflection() const noexcept { return *ptr_; }
+
+ private:
+  NodeRef(T* _ptr, std::shared_ptr<T>&& _owner)
+      : ptr_(_ptr), owner_(std::move(_owner)) {}
+
+ private:
+  /// Points to the node.
+  T* ptr_;
+
+  /// Owns the node, if it lives on the heap, empty otherwise.
+  std::shared_ptr<T> owner_;
+};
+
+}  // namespace sqlgen::dynamic
+
+#endif
@@ -6,11 +6,11 @@
 #include <string>
 #include <vector>
 
-#include "../Ref.hpp"
 #include "Condition.hpp"
 #include "GroupBy.hpp"
 #include "JoinType.hpp"
 #include "Limit.hpp"
+#include "NodeRef.hpp"
 #include "Operation.hpp"
 #include "OrderBy.hpp"
 #include "Table.hpp"
@@ -18,7 +18,7 @@
 namespace sqlgen::dynamic {
 
 struct SelectFrom {
-  using TableOrQueryType = rfl::Variant<Table, Ref<SelectFrom>>;
+  using TableOrQueryType = rfl::Variant<Table, NodeRef<SelectFrom>>;
 
   struct Field {
     Operation val;
@@ -1,6 +1,7 @@
 #ifndef SQLGEN_DYNAMIC_VALUE_HPP_
 #define SQLGEN_DYNAMIC_VALUE_HPP_
 
+#include <cstddef>
 #include <rfl.hpp>
 #include <string>
 
@@ -21,6 +22,15 @@ struct Integer {
   int64_t val;
 };
 
+/// A placeholder, whose value is bound when a prepared query is executed.
+struct Param {
+  std::string name;
+
+  /// The position of the value among the parameters of the statement,
+  /// starting at 1. Assigned when the statement is prepared.
+  size_t ix = 0;
+};
+
 struct String {
   std::string val;
 };
@@ -31,7 +41,8 @@ struct Timestamp {
 
 struct Value {
   using ReflectionType =
-      rfl::TaggedUnion<"type", Duration, Float, Integer, String, Timestamp>;
+      rfl::TaggedUnion<"type", Duration, Float, Integer, Param, String,
+                       Timestamp>;
   const auto& reflection() const { return val; }
   ReflectionType val;
 };
@@ -1,6 +1,7 @@
 #ifndef SQLGEN_DYNAMIC_WRITE_HPP_
 #define SQLGEN_DYNAMIC_WRITE_HPP_
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,10 @@ namespace sqlgen::dynamic {
 struct Write {
   Table table;
   std::vector<std::string> columns;
+
+  /// The number of rows inserted by a single statement, for backends that
+  /// do not support COPY.
+  size_t num_rows = 1;
 };
 
 }  // namespace sqlgen::dynamic
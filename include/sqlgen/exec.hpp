@@ -2,6 +2,8 @@
 #define SQLGEN_EXEC_HPP_
 
 #include <rfl.hpp>
+#include <string>
+#include <vector>
 
 #include "Ref.hpp"
 #include "Result.hpp"
@@ -31,6 +33,45 @@ struct Exec {
 
 inline auto exec(const std::string& _sql) { return Exec{.sql_ = _sql}; }
 
+/// Executes several statements. Connections that support it (such as
+/// postgres) send all of them before waiting for the results. Stops at the
+/// first statement that fails.
+template <class Connection>
+  requires is_connection<Connection>
+Result<Ref<Connection>> exec_many(const Ref<Connection>& _conn,
+                                  const std::vector<std::string>& _sqls) {
+  if constexpr (requires { _conn->execute_many(_sqls); }) {
+    return _conn->execute_many(_sqls).transform(
+        [&](const auto&) { return _conn; });
+  } else {
+    for (const auto& sql : _sqls) {
+      const auto res = _conn->execute(sql);
+      if (!res) {
+        return error(res.error().what());
+      }
+    }
+    return _conn;
+  }
+}
+
+template <class Connection>
+  requires is_connection<Connection>
+Result<Ref<Connection>> exec_many(const Result<Ref<Connection>>& _res,
+                                  const std::vector<std::string>& _sqls) {
+  return _res.and_then(
+      [&](const auto& _conn) { return exec_many(_conn, _sqls); });
+}
+
+struct ExecMany {
+  auto operator()(const auto& _conn) const { return exec_many(_conn, sqls_); }
+
+  std::vector<std::string> sqls_;
+};
+
+inline auto exec_many(const std::vector<std::string>& _sqls) {
+  return ExecMany{.sqls_ = _sqls};
+}
+
 };  // namespace sqlgen
 
 #endif
@@ -10,9 +10,10 @@
 #include <utility>
 #include <vector>
 
+#include "RowBatch.hpp"
 #include "internal/batch_size.hpp"
 #include "internal/has_constraint.hpp"
-#include "internal/to_str_vec.hpp"
+#include "internal/write_row.hpp"
 #include "is_connection.hpp"
 #include "transpilation/to_insert_or_write.hpp"
 
@@ -26,14 +27,20 @@ Result<Ref<Connection>> insert_impl(const Ref<Connection>& _conn,
   using T =
       std::remove_cvref_t<typename std::iterator_traits<ItBegin>::value_type>;
 
-  const auto insert_stmt =
-      transpilation::to_insert_or_write<T, dynamic::Insert>(_or_replace);
+  // The statements only depend on T, so they are only built once.
+  static const auto insert_only =
+      transpilation::to_insert_or_write<T, dynamic::Insert>(false);
+  static const auto or_replace =
+      transpilation::to_insert_or_write<T, dynamic::Insert>(true);
 
-  std::vector<std::vector<std::optional<std::string>>> data;
+  const auto& insert_stmt = _or_replace ? or_replace : insert_only;
+
+  RowBatch data(insert_stmt.columns.size());
 
   for (auto it = _begin; it != _end; ++it) {
-    data.emplace_back(internal::to_str_vec(*it));
-    if (data.size() == SQLGEN_BATCH_SIZE) {
+    internal::write_row(*it, &data);
+    if (data.size() == SQLGEN_BATCH_SIZE ||
+        data.num_bytes() >= SQLGEN_BATCH_BYTES) {
       const auto res = _conn->insert(insert_stmt, data);
       if (!res) {
         return error(res.error().what());
@@ -0,0 +1,61 @@
+#ifndef SQLGEN_INTERNAL_BATCHSIZER_HPP_
+#define SQLGEN_INTERNAL_BATCHSIZER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+
+#include "../RowBatch.hpp"
+#include "../batch_size.hpp"
+
+namespace sqlgen::internal {
+
+/// Keeps track of the number of rows to fetch in the next batch.
+class BatchSizer {
+ public:
+  BatchSizer(const BatchSize& _batch_size)
+      : batch_size_(_batch_size),
+        next_(std::clamp<size_t>(_batch_size.initial_rows, 1,
+                                 std::max<size_t>(_batch_size.max_rows, 1))),
+        num_bytes_(0),
+        num_rows_(0) {}
+
+  /// The number of rows to fetch in the next batch.
+  size_t next() const noexcept { return next_; }
+
+  /// Adapts the batch size to the batch that has just been fetched.
+  void update(const RowBatch& _batch) noexcept {
+    if (batch_size_.max_bytes == 0 || _batch.size() == 0) {
+      return;
+    }
+
+    // Besides the arena, every cell needs an offset, a length and a kind.
+    num_bytes_ +=
+        _batch.num_bytes() +
+        _batch.size() * _batch.num_cols() * (2 * sizeof(size_t) + 1);
+    num_rows_ += _batch.size();
+
+    const auto bytes_per_row = std::max<size_t>(num_bytes_ / num_rows_, 1);
+    const auto budget = std::max<size_t>(
+        batch_size_.max_bytes / bytes_per_row, 1);
+
+    next_ = std::min({next_ * 2, std::max<size_t>(batch_size_.max_rows, 1),
+                      budget});
+  }
+
+ private:
+  /// The configuration.
+  BatchSize batch_size_;
+
+  /// The number of rows to fetch in the next batch.
+  size_t next_;
+
+  /// The estimated number of bytes of all rows seen so far.
+  size_t num_bytes_;
+
+  /// The number of rows seen so far.
+  size_t num_rows_;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef SQLGEN_INTERNAL_PREFETCHER_HPP_
+#define SQLGEN_INTERNAL_PREFETCHER_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "../IteratorBase.hpp"
+#include "../Ref.hpp"
+
+namespace sqlgen::internal {
+
+/// Fetches and decodes batches on a worker thread, while the consumer is
+/// still busy with the batches it already has. At most _depth batches are
+/// kept in the queue. Once the prefetcher has been started, the underlying
+/// IteratorBase must only be accessed through it.
+template <class BatchType>
+class Prefetcher {
+ public:
+  using FetchFunction = std::function<BatchType(const Ref<IteratorBase>&)>;
+
+  Prefetcher(const Ref<IteratorBase>& _it, const size_t _depth,
+             const FetchFunction& _fetch)
+      : depth_(_depth == 0 ? 1 : _depth),
+        done_(false),
+        fetch_(_fetch),
+        it_(_it),
+        stop_(false) {
+    worker_ = std::thread([this]() { run(); });
+  }
+
+  Prefetcher(const Prefetcher&) = delete;
+
+  Prefetcher& operator=(const Prefetcher&) = delete;
+
+  ~Prefetcher() {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      stop_ = true;
+    }
+    not_full_.notify_one();
+    worker_.join();
+  }
+
+  /// Blocks until the next batch is available. Returns std::nullopt once
+  /// all batches have been consumed.
+  std::optional<BatchType> pop() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    not_empty_.wait(lock, [this]() { return !queue_.empty() || done_; });
+    if (queue_.empty()) {
+      return std::nullopt;
+    }
+    auto batch = std::move(queue_.front());
+    queue_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+    return batch;
+  }
+
+ private:
+  void run() {
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mtx_);
+        not_full_.wait(lock,
+                       [this]() { return queue_.size() < depth_ || stop_; });
+        if (stop_) {
+          break;
+        }
+      }
+
+      if (it_->end()) {
+        break;
+      }
+
+      auto batch = fetch_(it_);
+
+      // An empty batch signals an error, so we must not keep on fetching.
+      const bool empty = batch->empty();
+
+      {
+        std::lock_guard<std::mutex> lock(mtx_);
+        queue_.emplace_back(std::move(batch));
+      }
+      not_empty_.notify_one();
+
+      if (empty) {
+        break;
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      done_ = true;
+    }
+    not_empty_.notify_one();
+  }
+
+ private:
+  /// The maximum number of batches waiting to be consumed.
+  const size_t depth_;
+
+  /// Whether the worker has stopped producing batches.
+  bool done_;
+
+  /// Fetches and decodes the next batch.
+  const FetchFunction fetch_;
+
+  /// The underlying database iterator.
+  const Ref<IteratorBase> it_;
+
+  /// Protects queue_, done_ and stop_.
+  std::mutex mtx_;
+
+  /// Signalled when a batch has been added or the worker is done.
+  std::condition_variable not_empty_;
+
+  /// Signalled when a batch has been removed or the prefetcher is stopped.
+  std::condition_variable not_full_;
+
+  /// The batches that have been fetched, but not consumed.
+  std::deque<BatchType> queue_;
+
+  /// Whether the prefetcher is being destroyed.
+  bool stop_;
+
+  /// Runs run().
+  std::thread worker_;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
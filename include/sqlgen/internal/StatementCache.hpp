@@ -0,0 +1,117 @@
+#ifndef SQLGEN_INTERNAL_STATEMENTCACHE_HPP_
+#define SQLGEN_INTERNAL_STATEMENTCACHE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "../Result.hpp"
+#include "../StatementCacheStats.hpp"
+
+namespace sqlgen::internal {
+
+/// A least recently used cache of prepared statements, keyed by their SQL.
+/// Once the capacity is exceeded, the statement that has not been used for
+/// the longest time is evicted. A capacity of 0 disables the cache.
+template <class StmtType>
+class StatementCache {
+  using Entry = std::pair<std::string, StmtType>;
+
+ public:
+  /// Called for every statement that is removed from the cache.
+  using EvictFunction = std::function<void(const StmtType&)>;
+
+  StatementCache(const size_t _capacity,
+                 const EvictFunction& _evict = EvictFunction())
+      : capacity_(_capacity), evict_(_evict), hits_(0), misses_(0) {}
+
+  ~StatementCache() = default;
+
+  /// The maximum number of statements kept in the cache.
+  size_t capacity() const noexcept { return capacity_; }
+
+  /// Removes all statements from the cache.
+  void clear() {
+    while (!entries_.empty()) {
+      pop_back();
+    }
+  }
+
+  /// Returns the statement prepared for _sql, calling _prepare(_sql) if it
+  /// is not in the cache yet. If the cache is disabled, the statement is
+  /// not stored and the caller is responsible for releasing it.
+  template <class PrepareFunction>
+  Result<StmtType> get(const std::string& _sql,
+                       const PrepareFunction& _prepare) {
+    const auto it = index_.find(_sql);
+
+    if (it != index_.end()) {
+      ++hits_;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return it->second->second;
+    }
+
+    ++misses_;
+
+    Result<StmtType> stmt = _prepare(_sql);
+
+    if (!stmt || capacity_ == 0) {
+      return stmt;
+    }
+
+    while (entries_.size() >= capacity_) {
+      pop_back();
+    }
+
+    entries_.emplace_front(_sql, *stmt);
+    index_[_sql] = entries_.begin();
+
+    return stmt;
+  }
+
+  /// The current state of the cache.
+  StatementCacheStats stats() const noexcept {
+    return StatementCacheStats{.capacity = capacity_,
+                               .hits = hits_,
+                               .misses = misses_,
+                               .size = entries_.size()};
+  }
+
+ private:
+  /// Evicts the least recently used statement.
+  void pop_back() {
+    const auto entry = std::move(entries_.back());
+    index_.erase(entry.first);
+    entries_.pop_back();
+    if (evict_) {
+      evict_(entry.second);
+    }
+  }
+
+ private:
+  /// The maximum number of statements kept in the cache.
+  size_t capacity_;
+
+  /// The statements, the most recently used first.
+  std::list<Entry> entries_;
+
+  /// Called for every statement that is removed from the cache.
+  EvictFunction evict_;
+
+  /// The number of times a statement was found in the cache.
+  size_t hits_;
+
+  /// Points to the entry for every SQL string.
+  std::unordered_map<std::string, typename std::list<Entry>::iterator>
+      index_;
+
+  /// The number of times a statement had to be prepared.
+  size_t misses_;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
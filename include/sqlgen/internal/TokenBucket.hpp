@@ -0,0 +1,96 @@
+#ifndef SQLGEN_INTERNAL_TOKENBUCKET_HPP_
+#define SQLGEN_INTERNAL_TOKENBUCKET_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace sqlgen::internal {
+
+/// Limits the rate of some operation. The bucket holds up to _burst tokens
+/// and is refilled at _rate_per_second tokens per second. Every operation
+/// takes one token. A rate of 0 disables the limit. Thread-safe.
+template <class Clock = std::chrono::steady_clock>
+class TokenBucket {
+ public:
+  TokenBucket(const double _rate_per_second, const size_t _burst)
+      : burst_(static_cast<double>(std::max<size_t>(_burst, 1))),
+        last_(Clock::now()),
+        rate_per_second_(_rate_per_second),
+        tokens_(burst_) {}
+
+  ~TokenBucket() = default;
+
+  /// Whether the rate is limited at all.
+  bool enabled() const noexcept { return rate_per_second_ > 0.0; }
+
+  /// Returns a token that has been taken, but not used.
+  void give_back() {
+    if (!enabled()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    tokens_ = std::min(tokens_ + 1.0, burst_);
+  }
+
+  /// The point in time at which the next token will be available. Returns
+  /// time_point::max(), if the bucket is disabled or not empty, because
+  /// there is nothing to wait for.
+  typename Clock::time_point next_token() {
+    if (!enabled()) {
+      return Clock::time_point::max();
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    refill();
+    if (tokens_ >= 1.0) {
+      return Clock::time_point::max();
+    }
+    return last_ + std::chrono::duration_cast<typename Clock::duration>(
+                       std::chrono::duration<double>((1.0 - tokens_) /
+                                                     rate_per_second_));
+  }
+
+  /// Takes a token, if there is one.
+  bool try_take() {
+    if (!enabled()) {
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(mtx_);
+    refill();
+    if (tokens_ < 1.0) {
+      return false;
+    }
+    tokens_ -= 1.0;
+    return true;
+  }
+
+ private:
+  /// Adds the tokens that have accumulated since the last refill. Must be
+  /// called while holding mtx_.
+  void refill() {
+    const auto now = Clock::now();
+    const std::chrono::duration<double> elapsed = now - last_;
+    tokens_ = std::min(tokens_ + elapsed.count() * rate_per_second_, burst_);
+    last_ = now;
+  }
+
+ private:
+  /// The maximum number of tokens in the bucket.
+  double burst_;
+
+  /// The last time the bucket was refilled.
+  typename Clock::time_point last_;
+
+  std::mutex mtx_;
+
+  /// The number of tokens added per second.
+  double rate_per_second_;
+
+  /// The number of tokens currently in the bucket.
+  double tokens_;
+};
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -1,3 +1,7 @@
 #ifndef SQLGEN_BATCH_SIZE
 #define SQLGEN_BATCH_SIZE 50000
 #endif
+
+#ifndef SQLGEN_BATCH_BYTES
+#define SQLGEN_BATCH_BYTES (64 * 1024 * 1024)
+#endif
@@ -0,0 +1,71 @@
+#ifndef SQLGEN_INTERNAL_FORMAT_TIMESTAMP_HPP_
+#define SQLGEN_INTERNAL_FORMAT_TIMESTAMP_HPP_
+
+#include <array>
+#include <cstdlib>
+#include <ctime>
+#include <optional>
+#include <string_view>
+
+#include "timestamp_layout.hpp"
+
+namespace sqlgen::internal {
+
+/// Formats _tm according to _layout, producing the same output as strftime
+/// would, using _buf as the underlying storage. Returns std::nullopt for
+/// layouts and years it does not handle, so the caller can fall back to
+/// strftime.
+inline std::optional<std::string_view> format_timestamp(
+    const std::tm& _tm, const TimestampLayout _layout,
+    std::array<char, 32>* _buf) noexcept {
+  using Value = TimestampLayout::Value;
+
+  const int y = _tm.tm_year + 1900;
+  if (_layout.value == Value::other || y < 1000 || y > 9999 ||
+      _tm.tm_mon < 0 || _tm.tm_mon > 11 || _tm.tm_mday < 1 ||
+      _tm.tm_mday > 31 || _tm.tm_hour < 0 || _tm.tm_hour > 23 ||
+      _tm.tm_min < 0 || _tm.tm_min > 59 || _tm.tm_sec < 0 ||
+      _tm.tm_sec > 60) {
+    return std::nullopt;
+  }
+
+  char* ptr = _buf->data();
+
+  const auto digits = [&](const int _n, int _val) {
+    for (int i = _n - 1; i >= 0; --i) {
+      ptr[i] = static_cast<char>('0' + _val % 10);
+      _val /= 10;
+    }
+    ptr += _n;
+  };
+
+  digits(4, y);
+  *ptr++ = '-';
+  digits(2, _tm.tm_mon + 1);
+  *ptr++ = '-';
+  digits(2, _tm.tm_mday);
+
+  if (_layout.value != Value::date) {
+    *ptr++ = _layout.separator;
+    digits(2, _tm.tm_hour);
+    *ptr++ = ':';
+    digits(2, _tm.tm_min);
+    *ptr++ = ':';
+    digits(2, _tm.tm_sec);
+  }
+
+  if (_layout.value == Value::date_time_tz) {
+    const long offset = get_tm_gmtoff(_tm);
+    *ptr++ = offset < 0 ? '-' : '+';
+    const long minutes = std::labs(offset) / 60;
+    digits(2, static_cast<int>(minutes / 60 % 100));
+    digits(2, static_cast<int>(minutes % 60));
+  }
+
+  return std::string_view(_buf->data(),
+                          static_cast<size_t>(ptr - _buf->data()));
+}
+
+}  // namespace sqlgen::internal
+
+#endif
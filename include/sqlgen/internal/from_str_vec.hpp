@@ -12,46 +12,77 @@
 #include <vector>
 
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
 #include "../parsing/Parser.hpp"
+#include "../parsing/has_read_native.hpp"
 #include "call_destructors_where_necessary.hpp"
+#include "native_to_text.hpp"
 
 namespace sqlgen::internal {
 
-template <class ViewType, size_t i>
-void assign_if_field_is_field_i(
-    const std::vector<std::optional<std::string>>& _row, const size_t _i,
-    ViewType* _view, std::optional<Error>* _err) noexcept {
+/// Parses a single cell into T. Native cells are passed to
+/// Parser<T>::read_native(...), if the parser supports it, and are formatted
+/// as text otherwise.
+template <class T>
+Result<T> read_cell(const RowBatch::Cell& _cell) noexcept {
+  using Kind = RowBatch::Cell::Kind;
+  switch (_cell.kind()) {
+    case Kind::null_value:
+      return parsing::Parser<T>::read(std::nullopt);
+
+    case Kind::text:
+      return parsing::Parser<T>::read(_cell.text());
+
+    default:
+      if constexpr (parsing::has_read_native<T>) {
+        return parsing::Parser<T>::read_native(_cell);
+      } else {
+        std::array<char, 32> buf{};
+        return native_to_text(_cell, &buf).and_then(
+            [](const std::string_view _str) {
+              return parsing::Parser<T>::read(_str);
+            });
+      }
+  }
+}
+
+/// Parses column i into field i. Returns false on error.
+template <class ViewType, class RowType, size_t i>
+bool assign_field_i(const RowType& _row, ViewType* _view,
+                    std::optional<Error>* _err) noexcept {
   using FieldType = rfl::tuple_element_t<i, typename ViewType::Fields>;
-  using OriginalType = typename FieldType::Type;
   using T =
       std::remove_cvref_t<std::remove_pointer_t<typename FieldType::Type>>;
   constexpr auto name = FieldType::name();
-  if (_i == i) {
-    auto res = parsing::Parser<T>::read(_row[i]);
-    if (!res) {
-      std::stringstream stream;
-      stream << "Failed to parse field '" << std::string(name)
-             << "': " << res.error().what();
-      *_err = Error(stream.str());
-      return;
-    }
-    ::new (rfl::get<i>(*_view)) T(std::move(*res));
+  auto res = read_cell<T>(_row[i]);
+  if (!res) {
+    std::stringstream stream;
+    stream << "Failed to parse field '" << std::string(name)
+           << "': " << res.error().what();
+    *_err = Error(stream.str());
+    return false;
   }
+  ::new (rfl::get<i>(*_view)) T(std::move(*res));
+  return true;
 }
 
-template <class ViewType, size_t... is>
-std::optional<Error> assign_to_field_i(
-    const std::vector<std::optional<std::string>>& _row, const size_t _i,
-    ViewType* _view, std::integer_sequence<size_t, is...>) noexcept {
+/// Assigns the fields in order and stops at the first error. Returns the
+/// error, if any, and the number of fields that have been assigned.
+template <class ViewType, class RowType, size_t... is>
+std::pair<std::optional<Error>, size_t> assign_fields(
+    const RowType& _row, ViewType* _view,
+    std::integer_sequence<size_t, is...>) noexcept {
   std::optional<Error> err;
-  (assign_if_field_is_field_i<ViewType, is>(_row, _i, _view, &err), ...);
-  return err;
+  size_t num_fields_assigned = 0;
+  ((assign_field_i<ViewType, RowType, is>(_row, _view, &err) &&
+    (++num_fields_assigned, true)) &&
+   ...);
+  return std::make_pair(std::move(err), num_fields_assigned);
 }
 
-template <class ViewType>
+template <class ViewType, class RowType>
 std::pair<std::optional<Error>, size_t> read_into_view(
-    const std::vector<std::optional<std::string>>& _row,
-    ViewType* _view) noexcept {
+    const RowType& _row, ViewType* _view) noexcept {
   constexpr size_t size = ViewType::size();
   if (_row.size() != size) {
     std::stringstream stream;
@@ -59,23 +90,17 @@ std::pair<std::optional<Error>, size_t> read_into_view(
            << _row.size() << ".";
     return std::make_pair(Error(stream.str()), 0);
   }
-  for (size_t i = 0; i < size; ++i) {
-    const auto err = assign_to_field_i(
-        _row, i, _view, std::make_integer_sequence<size_t, size>());
-    if (err) {
-      return std::make_pair(err, i);
-    }
-  }
-  return std::make_pair(std::nullopt, size);
+  return assign_fields(_row, _view, std::make_integer_sequence<size_t, size>());
 }
 
-template <class T>
-Result<T> from_str_vec(
-    const std::vector<std::optional<std::string>>& _str_vec) {
+/// Parses a single row into T. RowType can be anything that returns the
+/// RowBatch::Cell in column i via operator[](i), such as a RowBatch::Row.
+template <class T, class RowType>
+Result<T> from_str_vec(const RowType& _row) {
   alignas(T) unsigned char buf[sizeof(T)]{};
   auto ptr = rfl::internal::ptr_cast<T*>(&buf);
   auto view = rfl::to_view(*ptr);
-  const auto [err, num_fields_assigned] = read_into_view(_str_vec, &view);
+  const auto [err, num_fields_assigned] = read_into_view(_row, &view);
   if (err) [[unlikely]] {
     call_destructors_where_necessary(num_fields_assigned, &view);
     return error(err->what());
@@ -0,0 +1,33 @@
+#ifndef SQLGEN_INTERNAL_MICROSECONDS_TO_TM_HPP_
+#define SQLGEN_INTERNAL_MICROSECONDS_TO_TM_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+namespace sqlgen::internal {
+
+/// Converts microseconds since the Unix epoch (UTC) to a std::tm. The
+/// fractional seconds are truncated.
+inline std::tm microseconds_to_tm(const std::int64_t _microseconds) noexcept {
+  using namespace std::chrono;
+  const auto tp = sys_time<microseconds>(microseconds(_microseconds));
+  const auto dp = floor<days>(tp);
+  const auto ymd = year_month_day(dp);
+  const auto hms = hh_mm_ss<seconds>(floor<seconds>(tp - dp));
+  std::tm tm{};
+  tm.tm_year = static_cast<int>(ymd.year()) - 1900;
+  tm.tm_mon = static_cast<int>(static_cast<unsigned>(ymd.month())) - 1;
+  tm.tm_mday = static_cast<int>(static_cast<unsigned>(ymd.day()));
+  tm.tm_hour = static_cast<int>(hms.hours().count());
+  tm.tm_min = static_cast<int>(hms.minutes().count());
+  tm.tm_sec = static_cast<int>(hms.seconds().count());
+  tm.tm_wday = static_cast<int>(weekday(dp).c_encoding());
+  tm.tm_yday =
+      static_cast<int>((dp - sys_days(ymd.year() / January / 1)).count());
+  return tm;
+}
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef SQLGEN_INTERNAL_NATIVE_TO_TEXT_HPP_
+#define SQLGEN_INTERNAL_NATIVE_TO_TEXT_HPP_
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <string_view>
+
+#include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "microseconds_to_tm.hpp"
+
+namespace sqlgen::internal {
+
+/// Formats a native cell as text, using _buf as the underlying storage.
+/// Timestamps are formatted as 'YYYY-MM-DD HH:MM:SS[.ffffff]'.
+inline Result<std::string_view> native_to_text(
+    const RowBatch::Cell& _cell, std::array<char, 32>* _buf) noexcept {
+  const auto begin = _buf->data();
+  const auto end = _buf->data() + _buf->size();
+
+  const auto to_view = [&](const std::to_chars_result _res)
+      -> Result<std::string_view> {
+    if (_res.ec != std::errc()) {
+      return error("Could not format native value.");
+    }
+    return std::string_view(begin, static_cast<size_t>(_res.ptr - begin));
+  };
+
+  switch (_cell.kind()) {
+    case RowBatch::Cell::Kind::int64:
+      return to_view(std::to_chars(begin, end, _cell.int64()));
+
+    case RowBatch::Cell::Kind::float64:
+      return to_view(std::to_chars(begin, end, _cell.float64()));
+
+    case RowBatch::Cell::Kind::timestamp: {
+      const auto us = _cell.timestamp();
+      const auto tm = microseconds_to_tm(us);
+      const auto fraction =
+          static_cast<int>(((us % 1000000) + 1000000) % 1000000);
+      const int n =
+          fraction == 0
+              ? std::snprintf(begin, _buf->size(),
+                              "%04d-%02d-%02d %02d:%02d:%02d",
+                              tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                              tm.tm_hour, tm.tm_min, tm.tm_sec)
+              : std::snprintf(begin, _buf->size(),
+                              "%04d-%02d-%02d %02d:%02d:%02d.%06d",
+                              tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                              tm.tm_hour, tm.tm_min, tm.tm_sec, fraction);
+      if (n < 0 || static_cast<size_t>(n) >= _buf->size()) {
+        return error("Could not format native value.");
+      }
+      return std::string_view(begin, static_cast<size_t>(n));
+    }
+
+    default:
+      return _cell.text();
+  }
+}
+
+}  // namespace sqlgen::internal
+
+#endif
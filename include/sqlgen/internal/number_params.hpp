@@ -0,0 +1,170 @@
+#ifndef SQLGEN_INTERNAL_NUMBER_PARAMS_HPP_
+#define SQLGEN_INTERNAL_NUMBER_PARAMS_HPP_
+
+#include <algorithm>
+#include <optional>
+#include <rfl.hpp>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "../dynamic/Condition.hpp"
+#include "../dynamic/NodeRef.hpp"
+#include "../dynamic/Operation.hpp"
+#include "../dynamic/SelectFrom.hpp"
+#include "../dynamic/Statement.hpp"
+#include "../dynamic/Value.hpp"
+
+namespace sqlgen::internal {
+
+inline void number_params(dynamic::Condition* _cond,
+                          std::vector<std::string>* _names);
+
+inline void number_params(dynamic::Operation* _op,
+                          std::vector<std::string>* _names);
+
+inline void number_params(dynamic::SelectFrom* _stmt,
+                          std::vector<std::string>* _names);
+
+inline void number_params(dynamic::Value* _val,
+                          std::vector<std::string>* _names) {
+  _val->val.visit([&](auto& _v) {
+    using Type = std::remove_cvref_t<decltype(_v)>;
+    if constexpr (std::is_same_v<Type, dynamic::Param>) {
+      const auto it = std::find(_names->begin(), _names->end(), _v.name);
+      if (it == _names->end()) {
+        _names->push_back(_v.name);
+        _v.ix = _names->size();
+      } else {
+        _v.ix = static_cast<size_t>(it - _names->begin()) + 1;
+      }
+    }
+  });
+}
+
+inline void number_params(dynamic::Condition* _cond,
+                          std::vector<std::string>* _names) {
+  _cond->val.visit([&](auto& _c) {
+    using Type = std::remove_cvref_t<decltype(_c)>;
+    if constexpr (requires { _c.cond1; }) {
+      number_params(_c.cond1.get(), _names);
+      number_params(_c.cond2.get(), _names);
+    } else if constexpr (std::is_same_v<Type, dynamic::Condition::Not>) {
+      number_params(_c.cond.get(), _names);
+    } else if constexpr (requires { _c.pattern; }) {
+      number_params(&_c.op, _names);
+      number_params(&_c.pattern, _names);
+    } else if constexpr (requires { _c.op1; }) {
+      number_params(&_c.op1, _names);
+      number_params(&_c.op2, _names);
+    } else {
+      number_params(&_c.op, _names);
+    }
+  });
+}
+
+inline void number_params(dynamic::Operation* _op,
+                          std::vector<std::string>* _names) {
+  _op->val.visit([&](auto& _o) {
+    using Type = std::remove_cvref_t<decltype(_o)>;
+    if constexpr (std::is_same_v<Type, dynamic::Value>) {
+      number_params(&_o, _names);
+
+    } else if constexpr (std::is_same_v<Type, dynamic::Aggregation>) {
+      _o.val.visit([&](auto& _agg) {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(_agg.val)>,
+                                     dynamic::NodeRef<dynamic::Operation>>) {
+          number_params(_agg.val.get(), _names);
+        }
+      });
+
+    } else {
+      if constexpr (requires { _o.date; }) {
+        number_params(_o.date.get(), _names);
+      }
+      if constexpr (requires { _o.ops; }) {
+        for (auto& op : _o.ops) {
+          number_params(op.get(), _names);
+        }
+      }
+      if constexpr (requires { _o.op1; }) {
+        number_params(_o.op1.get(), _names);
+      }
+      if constexpr (requires { _o.op2; }) {
+        number_params(_o.op2.get(), _names);
+      }
+      if constexpr (requires { _o.op3; }) {
+        number_params(_o.op3.get(), _names);
+      }
+    }
+  });
+}
+
+inline void number_params(dynamic::SelectFrom* _stmt,
+                          std::vector<std::string>* _names) {
+  for (auto& field : _stmt->fields) {
+    number_params(&field.val, _names);
+  }
+
+  const auto number_table_or_query =
+      [&](dynamic::SelectFrom::TableOrQueryType* _t) {
+        _t->visit([&](auto& _tq) {
+          using Type = std::remove_cvref_t<decltype(_tq)>;
+          if constexpr (std::is_same_v<Type,
+                                       dynamic::NodeRef<dynamic::SelectFrom>>) {
+            number_params(_tq.get(), _names);
+          }
+        });
+      };
+
+  number_table_or_query(&_stmt->table_or_query);
+
+  if (_stmt->joins) {
+    for (auto& join : *_stmt->joins) {
+      number_table_or_query(&join.table_or_query);
+      if (join.on) {
+        number_params(&*join.on, _names);
+      }
+    }
+  }
+
+  if (_stmt->where) {
+    number_params(&*_stmt->where, _names);
+  }
+}
+
+/// Assigns a position to every parameter in _stmt, such that all parameters
+/// with the same name share the same position. Returns the names of the
+/// parameters, ordered by their position.
+inline std::vector<std::string> number_params(dynamic::Statement* _stmt) {
+  std::vector<std::string> names;
+  _stmt->visit([&](auto& _s) {
+    using Type = std::remove_cvref_t<decltype(_s)>;
+    if constexpr (std::is_same_v<Type, dynamic::SelectFrom>) {
+      number_params(&_s, &names);
+
+    } else if constexpr (std::is_same_v<Type, dynamic::Update>) {
+      for (auto& set : _s.sets) {
+        set.to.visit([&](auto& _to) {
+          using ToType = std::remove_cvref_t<decltype(_to)>;
+          if constexpr (std::is_same_v<ToType, dynamic::Value>) {
+            number_params(&_to, &names);
+          }
+        });
+      }
+      if (_s.where) {
+        number_params(&*_s.where, &names);
+      }
+
+    } else if constexpr (std::is_same_v<Type, dynamic::DeleteFrom>) {
+      if (_s.where) {
+        number_params(&*_s.where, &names);
+      }
+    }
+  });
+  return names;
+}
+
+}  // namespace sqlgen::internal
+
+#endif
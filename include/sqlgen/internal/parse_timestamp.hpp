@@ -0,0 +1,135 @@
+#ifndef SQLGEN_INTERNAL_PARSE_TIMESTAMP_HPP_
+#define SQLGEN_INTERNAL_PARSE_TIMESTAMP_HPP_
+
+#include <chrono>
+#include <ctime>
+#include <optional>
+#include <string_view>
+
+#include "timestamp_layout.hpp"
+
+namespace sqlgen::internal {
+
+/// Parses 'YYYY-MM-DD', 'YYYY-MM-DD HH:MM:SS[.ffffff]' or
+/// 'YYYY-MM-DD HH:MM:SS[.ffffff](Z|+HH|+HHMM|+HH:MM)' at fixed offsets,
+/// depending on _layout. 'T' is accepted in place of the space. Fractional
+/// seconds are dropped, because std::tm cannot hold them. Returns
+/// std::nullopt if _str does not have the expected shape, so the caller can
+/// fall back to strptime.
+inline std::optional<std::tm> parse_timestamp(
+    const std::string_view _str, const TimestampLayout _layout) noexcept {
+  using Value = TimestampLayout::Value;
+
+  const char* ptr = _str.data();
+  const char* const end = _str.data() + _str.size();
+
+  const auto digits = [&](const int _n, int* _val) {
+    if (end - ptr < _n) {
+      return false;
+    }
+    int val = 0;
+    for (int i = 0; i < _n; ++i, ++ptr) {
+      const auto d = static_cast<unsigned>(*ptr - '0');
+      if (d > 9) {
+        return false;
+      }
+      val = val * 10 + static_cast<int>(d);
+    }
+    *_val = val;
+    return true;
+  };
+
+  const auto literal = [&](const char _c) {
+    if (ptr == end || *ptr != _c) {
+      return false;
+    }
+    ++ptr;
+    return true;
+  };
+
+  int y = 0, m = 0, d = 0, hh = 0, mm = 0, ss = 0;
+
+  if (!digits(4, &y) || !literal('-') || !digits(2, &m) || !literal('-') ||
+      !digits(2, &d)) {
+    return std::nullopt;
+  }
+
+  if (_layout.value != Value::date) {
+    if (ptr == end || (*ptr != ' ' && *ptr != 'T')) {
+      return std::nullopt;
+    }
+    ++ptr;
+
+    if (!digits(2, &hh) || !literal(':') || !digits(2, &mm) ||
+        !literal(':') || !digits(2, &ss)) {
+      return std::nullopt;
+    }
+
+    if (hh > 23 || mm > 59 || ss > 60) {
+      return std::nullopt;
+    }
+
+    if (literal('.')) {
+      const char* const fraction = ptr;
+      while (ptr != end && static_cast<unsigned>(*ptr - '0') <= 9) {
+        ++ptr;
+      }
+      if (ptr == fraction) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  std::tm tm{};
+
+  if (_layout.value == Value::date_time_tz) {
+    if (!literal('Z')) {
+      if (ptr == end || (*ptr != '+' && *ptr != '-')) {
+        return std::nullopt;
+      }
+      const bool negative = *ptr++ == '-';
+      int oh = 0, om = 0;
+      if (!digits(2, &oh)) {
+        return std::nullopt;
+      }
+      if (ptr != end) {
+        literal(':');
+        if (!digits(2, &om)) {
+          return std::nullopt;
+        }
+      }
+      if (oh > 23 || om > 59) {
+        return std::nullopt;
+      }
+      const long offset = oh * 3600L + om * 60L;
+      set_tm_gmtoff(negative ? -offset : offset, &tm);
+    }
+  }
+
+  if (ptr != end) {
+    return std::nullopt;
+  }
+
+  using namespace std::chrono;
+  const auto ymd = year_month_day(year(y), month(static_cast<unsigned>(m)),
+                                  day(static_cast<unsigned>(d)));
+  if (!ymd.ok()) {
+    return std::nullopt;
+  }
+  const auto dp = sys_days(ymd);
+
+  tm.tm_year = y - 1900;
+  tm.tm_mon = m - 1;
+  tm.tm_mday = d;
+  tm.tm_hour = hh;
+  tm.tm_min = mm;
+  tm.tm_sec = ss;
+  tm.tm_wday = static_cast<int>(weekday(dp).c_encoding());
+  tm.tm_yday =
+      static_cast<int>((dp - sys_days(ymd.year() / January / 1)).count());
+  return tm;
+}
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef SQLGEN_INTERNAL_TIMESTAMP_LAYOUT_HPP_
+#define SQLGEN_INTERNAL_TIMESTAMP_LAYOUT_HPP_
+
+#include <ctime>
+#include <string_view>
+
+namespace sqlgen::internal {
+
+/// Describes timestamp formats that can be parsed and formatted using fixed
+/// offsets, without going through strptime and strftime.
+struct TimestampLayout {
+  enum class Value { other, date, date_time, date_time_tz };
+
+  /// The shape of the format.
+  Value value = Value::other;
+
+  /// The character between the date and the time, ' ' or 'T'.
+  char separator = ' ';
+
+  bool operator==(const TimestampLayout&) const = default;
+};
+
+/// Not every platform has std::tm::tm_gmtoff, which is needed to represent
+/// the offset of '%z'.
+template <class TMType>
+constexpr bool has_tm_gmtoff = requires(TMType _tm) { _tm.tm_gmtoff; };
+
+/// The offset from UTC in seconds, or 0 if it cannot be represented.
+template <class TMType>
+long get_tm_gmtoff(const TMType& _tm) noexcept {
+  if constexpr (has_tm_gmtoff<TMType>) {
+    return static_cast<long>(_tm.tm_gmtoff);
+  } else {
+    return 0;
+  }
+}
+
+/// Sets the offset from UTC in seconds, if it can be represented.
+template <class TMType>
+void set_tm_gmtoff(const long _offset, TMType* _tm) noexcept {
+  if constexpr (has_tm_gmtoff<TMType>) {
+    _tm->tm_gmtoff = _offset;
+  }
+}
+
+/// Recognizes '%Y-%m-%d' and '%F', optionally followed by ' ' or 'T' and
+/// '%H:%M:%S' or '%T', optionally followed by '%z'. Everything else is
+/// Value::other.
+constexpr TimestampLayout to_timestamp_layout(
+    std::string_view _format) noexcept {
+  using Value = TimestampLayout::Value;
+
+  const auto consume = [&](const std::string_view _prefix) {
+    if (_format.starts_with(_prefix)) {
+      _format.remove_prefix(_prefix.size());
+      return true;
+    }
+    return false;
+  };
+
+  if (!consume("%Y-%m-%d") && !consume("%F")) {
+    return TimestampLayout{};
+  }
+
+  if (_format.empty()) {
+    return TimestampLayout{.value = Value::date};
+  }
+
+  const char separator = _format.front();
+  if (separator != ' ' && separator != 'T') {
+    return TimestampLayout{};
+  }
+  _format.remove_prefix(1);
+
+  if (!consume("%H:%M:%S") && !consume("%T")) {
+    return TimestampLayout{};
+  }
+
+  if (_format.empty()) {
+    return TimestampLayout{.value = Value::date_time, .separator = separator};
+  }
+
+  if (_format == "%z" && has_tm_gmtoff<std::tm>) {
+    return TimestampLayout{.value = Value::date_time_tz,
+                           .separator = separator};
+  }
+
+  return TimestampLayout{};
+}
+
+}  // namespace sqlgen::internal
+
+#endif
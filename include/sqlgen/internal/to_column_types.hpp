@@ -0,0 +1,36 @@
+#ifndef SQLGEN_INTERNAL_TO_COLUMN_TYPES_HPP_
+#define SQLGEN_INTERNAL_TO_COLUMN_TYPES_HPP_
+
+#include <rfl.hpp>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../dynamic/Type.hpp"
+#include "../parsing/Parser.hpp"
+
+namespace sqlgen::internal {
+
+template <class FieldType>
+dynamic::Type to_column_type() {
+  using T =
+      std::remove_cvref_t<std::remove_pointer_t<typename FieldType::Type>>;
+  return parsing::Parser<T>::to_type();
+}
+
+/// Returns the types of the fields of T, in the order in which they are
+/// expected to be returned by the database.
+template <class T>
+std::vector<dynamic::Type> to_column_types() {
+  using ViewType = std::remove_cvref_t<decltype(rfl::to_view(
+      std::declval<std::remove_cvref_t<T>&>()))>;
+  using Fields = typename ViewType::Fields;
+  return []<size_t... is>(std::integer_sequence<size_t, is...>) {
+    return std::vector<dynamic::Type>(
+        {to_column_type<rfl::tuple_element_t<is, Fields>>()...});
+  }(std::make_integer_sequence<size_t, ViewType::size()>());
+}
+
+}  // namespace sqlgen::internal
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef SQLGEN_INTERNAL_WRITE_ROW_HPP_
+#define SQLGEN_INTERNAL_WRITE_ROW_HPP_
+
+#include <rfl.hpp>
+#include <type_traits>
+
+#include "../parsing/Parser.hpp"
+#include "../parsing/write_to.hpp"
+#include "remove_auto_incr_primary_t.hpp"
+
+namespace sqlgen::internal {
+
+/// Appends the fields of _t to _sink, which is usually a RowBatch.
+/// Auto-incrementing primary keys are skipped.
+template <class T, class SinkType>
+void write_row(const T& _t, SinkType* _sink) {
+  const auto view = rfl::to_view(_t);
+  using ViewType = remove_auto_incr_primary_t<decltype(view)>;
+  rfl::apply(
+      [&](const auto... _ptrs) { (parsing::write_to(*_ptrs, _sink), ...); },
+      ViewType(view).values());
+}
+
+}  // namespace sqlgen::internal
+
+#endif
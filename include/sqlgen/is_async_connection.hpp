@@ -0,0 +1,62 @@
+#ifndef SQLGEN_ISASYNCCONNECTION_HPP_
+#define SQLGEN_ISASYNCCONNECTION_HPP_
+
+#include <concepts>
+#include <string>
+
+#include "IteratorBase.hpp"
+#include "Ref.hpp"
+#include "Result.hpp"
+#include "RowBatch.hpp"
+#include "Task.hpp"
+#include "dynamic/Statement.hpp"
+
+namespace sqlgen {
+
+/// The concept any asynchronous connection needs to implement. Instead of
+/// blocking, the operations return tasks, which can be awaited from a
+/// coroutine.
+template <class ConnType>
+concept is_async_connection =
+    requires(ConnType c, std::string _sql, dynamic::Statement _stmt,
+             const RowBatch& _data) {
+      /// Begins a transaction.
+      { c.begin_transaction() } -> std::same_as<Task<Result<Nothing>>>;
+
+      /// Commits a transaction.
+      { c.commit() } -> std::same_as<Task<Result<Nothing>>>;
+
+      /// Executes a statement.
+      { c.execute(_sql) } -> std::same_as<Task<Result<Nothing>>>;
+
+      /// Executes a statement containing parameters, binding the values in
+      /// the first row of _data to them, in the order of their positions.
+      { c.execute(_sql, _data) } -> std::same_as<Task<Result<Nothing>>>;
+
+      /// Reads the results of a SELECT statement, that has already been
+      /// transpiled and may contain parameters, binding the values in the
+      /// first row of _data to them.
+      {
+        c.read(_sql, _data)
+      } -> std::same_as<Task<Result<Ref<IteratorBase>>>>;
+
+      /// Rolls back a transaction.
+      { c.rollback() } -> std::same_as<Task<Result<Nothing>>>;
+
+      /// Transpiles a statement to a particular SQL dialect.
+      { c.to_sql(_stmt) } -> std::same_as<std::string>;
+    };
+
+/// Executes _sql on _conn and returns _conn, so that asynchronous queries
+/// can be chained like their blocking counterparts.
+template <class Connection>
+  requires is_async_connection<Connection>
+Task<Result<Ref<Connection>>> execute_async(const Ref<Connection> _conn,
+                                            const std::string _sql) {
+  const auto res = co_await _conn->execute(_sql);
+  co_return res.transform([&](const auto&) { return _conn; });
+}
+
+}  // namespace sqlgen
+
+#endif
@@ -9,6 +9,7 @@
 #include "IteratorBase.hpp"
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "RowBatch.hpp"
 #include "dynamic/SelectFrom.hpp"
 #include "dynamic/Statement.hpp"
 #include "dynamic/Write.hpp"
@@ -21,7 +22,7 @@ concept is_connection =
     requires(ConnType c, std::string _sql, dynamic::Statement _stmt,
              dynamic::SelectFrom _select_from, dynamic::Insert _insert,
              const dynamic::Write& _write,
-             std::vector<std::vector<std::optional<std::string>>> _data) {
+             const RowBatch& _data) {
       /// Begins a transaction.
       { c.begin_transaction() } -> std::same_as<Result<Nothing>>;
 
@@ -31,6 +32,10 @@ concept is_connection =
       /// Executes a statement.
       { c.execute(_sql) } -> std::same_as<Result<Nothing>>;
 
+      /// Executes a statement containing parameters, binding the values in
+      /// the first row of _data to them, in the order of their positions.
+      { c.execute(_sql, _data) } -> std::same_as<Result<Nothing>>;
+
       /// Inserts data into the database using the INSERT statement.
       /// More minimal approach than write, but can be used inside transactions.
       { c.insert(_insert, _data) } -> std::same_as<Result<Nothing>>;
@@ -38,6 +43,11 @@ concept is_connection =
       /// Reads the results of a SelectFrom statement.
       { c.read(_select_from) } -> std::same_as<Result<Ref<IteratorBase>>>;
 
+      /// Reads the results of a SELECT statement, that has already been
+      /// transpiled and may contain parameters, binding the values in the
+      /// first row of _data to them.
+      { c.read(_sql, _data) } -> std::same_as<Result<Ref<IteratorBase>>>;
+
       /// Commits a transaction.
       { c.rollback() } -> std::same_as<Result<Nothing>>;
 
@@ -50,7 +60,7 @@ concept is_connection =
       /// Ends the write operation and thus commits the results.
       { c.end_write() } -> std::same_as<Result<Nothing>>;
 
-      /// Writes data into a table. Each vector in data MUST have the same
+      /// Writes data into a table. Each row in data MUST have the same
       /// length as _stmt.columns. You MUST call .start_write(...) first and
       /// call .end_write() after all the data has been written. You CAN write
       /// the data in chunks, meaning you can call .write(...) more than once
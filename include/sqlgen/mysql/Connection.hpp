@@ -4,17 +4,22 @@
 #include <mysql.h>
 
 #include <memory>
+#include <optional>
 #include <rfl.hpp>
 #include <stdexcept>
 #include <string>
+#include <variant>
 
 #include "../IteratorBase.hpp"
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../StatementCacheStats.hpp"
 #include "../Transaction.hpp"
 #include "../dynamic/Column.hpp"
 #include "../dynamic/Statement.hpp"
 #include "../dynamic/Write.hpp"
+#include "../internal/StatementCache.hpp"
 #include "../is_connection.hpp"
 #include "Credentials.hpp"
 #include "exec.hpp"
@@ -26,9 +31,20 @@ class Connection {
   using ConnPtr = Ref<MYSQL>;
   using StmtPtr = std::shared_ptr<MYSQL_STMT>;
 
+  /// The maximum number of placeholders MySQL accepts in a single prepared
+  /// statement. Determines how many rows a single INSERT can insert.
+  static constexpr size_t max_params_ = 65535;
+
+  /// The maximum number of bytes of parameters sent by a single execution of
+  /// an INSERT. The server rejects packets larger than max_allowed_packet,
+  /// which is 4 MiB by default on MySQL 5.7 and larger on newer servers.
+  static constexpr size_t max_bytes_ = 4 * 1024 * 1024;
+
  public:
   Connection(const Credentials& _credentials)
-      : conn_(make_conn(_credentials)) {}
+      : conn_(make_conn(_credentials)),
+        prefetch_rows_(_credentials.prefetch_rows),
+        stmt_cache_(_credentials.statement_cache_size) {}
 
   static rfl::Result<Ref<Connection>> make(
       const Credentials& _credentials) noexcept;
@@ -45,13 +61,32 @@ class Connection {
     return exec(conn_, _sql);
   }
 
-  Result<Nothing> insert(
-      const dynamic::Insert& _stmt,
-      const std::vector<std::vector<std::optional<std::string>>>&
-          _data) noexcept;
+  /// Executes _sql as a prepared statement, binding the values in the
+  /// first row of _params to its parameters.
+  Result<Nothing> execute(const std::string& _sql,
+                          const RowBatch& _params) noexcept;
+
+  Result<Nothing> insert(const dynamic::Insert& _stmt,
+                         const RowBatch& _data) noexcept;
+
+  /// Whether the connection to the server is still usable. Sends a ping to
+  /// the server.
+  bool is_alive() noexcept { return mysql_ping(conn_.get()) == 0; }
 
   Result<Ref<IteratorBase>> read(const dynamic::SelectFrom& _query);
 
+  /// Reads the results of the SELECT statement _sql, binding the values in
+  /// the first row of _params to its parameters.
+  Result<Ref<IteratorBase>> read(const std::string& _sql,
+                                 const RowBatch& _params);
+
+  /// Returns the values in the first row of _params in the order in which
+  /// the placeholders appear in _sql. MySQL binds the values by the order
+  /// of the placeholders, which is why every placeholder keeps the
+  /// position of its parameter in a comment.
+  static Result<RowBatch> order_params(const std::string& _sql,
+                                       const RowBatch& _params) noexcept;
+
   Result<Nothing> rollback() noexcept { return execute("ROLLBACK;"); }
 
   std::string to_sql(const dynamic::Statement& _stmt) noexcept {
@@ -60,31 +95,56 @@ class Connection {
 
   Result<Nothing> start_write(const dynamic::Write& _stmt);
 
-  Result<Nothing> write(
-      const std::vector<std::vector<std::optional<std::string>>>& _data);
+  /// The number of hits and misses of the prepared statement cache.
+  StatementCacheStats statement_cache_stats() const noexcept {
+    return stmt_cache_.stats();
+  }
+
+  Result<Nothing> write(const RowBatch& _data);
 
   Result<Nothing> end_write();
 
  private:
-  /// Actually inserts data based on a prepared statement -
-  /// used by both .insert(...) and .write(...).
-  Result<Nothing> actual_insert(
-      const std::vector<std::vector<std::optional<std::string>>>& _data,
-      MYSQL_STMT* _stmt) const noexcept;
+  /// Actually inserts the rows _begin to _end based on a prepared statement,
+  /// which must insert exactly that many rows.
+  Result<Nothing> actual_insert(const RowBatch& _data, const size_t _begin,
+                                const size_t _end,
+                                MYSQL_STMT* _stmt) const noexcept;
+
+  /// Inserts all rows in _data, using statements that insert as many rows at
+  /// once as the placeholder and packet limits allow - used by both
+  /// .insert(...) and .write(...).
+  Result<Nothing> insert_rows(
+      const std::variant<dynamic::Insert, dynamic::Write>& _stmt,
+      const RowBatch& _data) noexcept;
 
   static ConnPtr make_conn(const Credentials& _credentials);
 
-  Result<StmtPtr> prepare_statement(
-      const std::variant<dynamic::Insert, dynamic::Write>& _stmt)
-      const noexcept;
+  /// Returns the prepared statement for _stmt from the cache, preparing it
+  /// if necessary.
+  Result<StmtPtr> get_statement(
+      const std::variant<dynamic::Insert, dynamic::Write>& _stmt) noexcept;
+
+  Result<StmtPtr> prepare_statement(const std::string& _sql) const noexcept;
+
+  /// The number of rows of _data a single INSERT can hold without exceeding
+  /// max_params_ or max_bytes_.
+  static size_t rows_per_statement(const RowBatch& _data) noexcept;
 
  private:
-  /// A prepared statement - needed for the read and write operations. Note that
-  /// we have declared it before conn_, meaning it will be destroyed first.
-  StmtPtr stmt_;
+  /// The statement passed to .start_write(...) - needed for the write
+  /// operations.
+  std::optional<dynamic::Write> write_stmt_;
 
   /// The underlying connection.
   ConnPtr conn_;
+
+  /// The number of rows to prefetch when reading through a cursor.
+  unsigned long prefetch_rows_;
+
+  /// Keeps the most recently used prepared statements. Declared after
+  /// conn_, so that the statements are closed before the connection.
+  internal::StatementCache<StmtPtr> stmt_cache_;
 };
 
 static_assert(is_connection<Connection>,
@@ -1,6 +1,7 @@
 #ifndef SQLGEN_MYSQL_CREDENTIALS_HPP_
 #define SQLGEN_MYSQL_CREDENTIALS_HPP_
 
+#include <cstddef>
 #include <string>
 
 namespace sqlgen::mysql {
@@ -12,6 +13,14 @@ struct Credentials {
   std::string dbname = "mysql";
   int port = 3306;
   std::string unix_socket = "/var/run/mysqld/mysqld.sock";
+
+  /// The number of rows the server sends per round trip when reading
+  /// through a server-side cursor (STMT_ATTR_PREFETCH_ROWS).
+  unsigned long prefetch_rows = 10000;
+
+  /// The number of prepared statements kept per connection. Set it to 0 to
+  /// disable the cache.
+  size_t statement_cache_size = 100;
 };
 
 }  // namespace sqlgen::mysql
@@ -3,6 +3,7 @@
 
 #include <mysql.h>
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -11,16 +12,33 @@
 #include "../IteratorBase.hpp"
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../dynamic/Type.hpp"
 #include "Connection.hpp"
 
 namespace sqlgen::mysql {
 
 class Iterator : public sqlgen::IteratorBase {
   using ConnPtr = Ref<MYSQL>;
-  using ResPtr = Ref<MYSQL_RES>;
+  using StmtPtr = Ref<MYSQL_STMT>;
+
+  /// The kind of output buffer a column is bound to.
+  enum class BufferType { int64, float64, datetime, string };
+
+  /// The output buffer for a single column.
+  struct Column {
+    BufferType type = BufferType::string;
+    std::int64_t int64 = 0;
+    double float64 = 0.0;
+    MYSQL_TIME time{};
+    std::vector<char> str;
+    unsigned long length = 0;
+    my_bool is_null = 0;
+    my_bool error = 0;
+  };
 
  public:
-  Iterator(const ResPtr& _res, const ConnPtr& _conn);
+  Iterator(const StmtPtr& _stmt, const ConnPtr& _conn);
 
   ~Iterator();
 
@@ -30,12 +48,37 @@ class Iterator : public sqlgen::IteratorBase {
   /// Returns the next batch of rows.
   /// If _batch_size is greater than the number of rows left, returns all
   /// of the rows left.
-  Result<std::vector<std::vector<std::optional<std::string>>>> next(
-      const size_t _batch_size) final;
+  Result<RowBatch> next(const size_t _batch_size) final;
+
+  /// Integer, floating point and timestamp columns are bound to typed output
+  /// buffers, if the types of the fields they are read into match.
+  void set_column_types(const std::vector<dynamic::Type>& _types) final;
+
+ private:
+  /// Binds the output buffers to the statement. Must be called before the
+  /// first row is fetched.
+  Result<Nothing> bind();
+
+  /// Appends the value in column _j to _batch, fetching it again if it did
+  /// not fit into the output buffer.
+  Result<Nothing> push_back(const size_t _j, RowBatch* _batch);
 
  private:
-  /// The underlying mysql result.
-  ResPtr res_;
+  /// Whether the output buffers have been bound.
+  bool bound_;
+
+  /// The output buffers for each column.
+  std::vector<Column> cols_;
+
+  /// The preferred buffer types, as derived from set_column_types(...).
+  std::vector<BufferType> hints_;
+
+  /// The bindings pointing to cols_.
+  std::vector<MYSQL_BIND> binds_;
+
+  /// The underlying prepared statement. Note that we have declared it before
+  /// conn_, meaning it will be destroyed first.
+  StmtPtr stmt_;
 
   /// The underlying mysql connection. We have this in here to prevent its
   /// destruction for the lifetime of the iterator.
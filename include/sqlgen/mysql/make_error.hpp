@@ -17,6 +17,12 @@ inline rfl::Unexpected<Error> make_error(const Ref<MYSQL>& _conn) noexcept {
                mysql_error(_conn.get()));
 }
 
+inline rfl::Unexpected<Error> make_error(MYSQL_STMT* _stmt) noexcept {
+  return error("MySQL error (" + std::to_string(mysql_stmt_errno(_stmt)) +
+               ") [" + mysql_stmt_sqlstate(_stmt) + "] " +
+               mysql_stmt_error(_stmt));
+}
+
 }  // namespace sqlgen::mysql
 
 #endif
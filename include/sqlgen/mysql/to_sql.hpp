@@ -4,6 +4,7 @@
 #include <string>
 #include <type_traits>
 
+#include "../dynamic/Arena.hpp"
 #include "../dynamic/Statement.hpp"
 #include "../transpilation/to_sql.hpp"
 
@@ -18,6 +19,7 @@ std::string to_sql(const T& _t) noexcept {
   if constexpr (std::is_same_v<std::remove_cvref_t<T>, dynamic::Statement>) {
     return to_sql_impl(_t);
   } else {
+    dynamic::Arena arena;
     return to_sql_impl(transpilation::to_sql(_t));
   }
 }
@@ -0,0 +1,31 @@
+#ifndef SQLGEN_PARAM_HPP_
+#define SQLGEN_PARAM_HPP_
+
+#include <rfl.hpp>
+
+#include "transpilation/Param.hpp"
+#include "transpilation/to_transpilation_type.hpp"
+
+namespace sqlgen {
+
+/// A placeholder for a value in a prepared query. The value is taken from
+/// the field called _name of the parameters passed at execution time.
+template <rfl::internal::StringLiteral _name>
+auto param() noexcept {
+  return transpilation::Param<_name>{};
+}
+
+namespace transpilation {
+
+template <rfl::internal::StringLiteral _name>
+struct ToTranspilationType<Param<_name>> {
+  using Type = Param<_name>;
+
+  Type operator()(const auto&) const noexcept { return Param<_name>{}; }
+};
+
+}  // namespace transpilation
+
+}  // namespace sqlgen
+
+#endif
@@ -1,16 +1,26 @@
 #ifndef SQLGEN_PARSING_PARSER_DEFAULT_HPP_
 #define SQLGEN_PARSING_PARSER_DEFAULT_HPP_
 
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <ranges>
 #include <rfl.hpp>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
 #include "../dynamic/Type.hpp"
 #include "../dynamic/types.hpp"
 #include "../transpilation/has_reflection_method.hpp"
 #include "Parser_base.hpp"
+#include "has_read_native.hpp"
+#include "parse_number.hpp"
+#include "write_to.hpp"
 
 namespace sqlgen::parsing {
 
@@ -18,7 +28,8 @@ template <class T>
 struct Parser {
   using Type = std::remove_cvref_t<T>;
 
-  static Result<T> read(const std::optional<std::string>& _str) noexcept {
+  static Result<T> read(
+      const std::optional<std::string_view>& _str) noexcept {
     if constexpr (transpilation::has_reflection_method<Type>) {
       return Parser<std::remove_cvref_t<typename Type::ReflectionType>>::read(
                  _str)
@@ -29,37 +40,157 @@ struct Parser {
         return error("NULL value encounted: Numeric value cannot be NULL.");
       }
 
-      try {
-        if constexpr (std::is_floating_point_v<Type>) {
-          return static_cast<Type>(std::stod(*_str));
-        } else if constexpr (std::is_integral_v<Type>) {
-          return static_cast<Type>(std::stoll(*_str));
-        } else if constexpr (std::is_same_v<Type, bool>) {
-          return std::stoi(*_str) != 0;
-        } else if constexpr (std::is_enum_v<Type>) {
-          if (auto res = rfl::string_to_enum<Type>(*_str)) {
-            return Type{*res};
-          } else {
-            return error(res.error());
+      if constexpr (std::is_same_v<Type, bool>) {
+        const auto str = *_str;
+        if (str == "t" || str == "true" || str == "TRUE") {
+          return true;
+        } else if (str == "f" || str == "false" || str == "FALSE") {
+          return false;
+        }
+        return parse_number<long long>(str).transform(
+            [](const long long _val) { return _val != 0; });
+
+      } else if constexpr (std::is_arithmetic_v<Type>) {
+        return parse_number<Type>(*_str);
+
+      } else if constexpr (std::is_enum_v<Type>) {
+        constexpr auto enumerators = rfl::get_enumerator_array<Type>();
+        for (const auto& [name, value] : enumerators) {
+          if (name == *_str) {
+            return value;
           }
-        } else {
-          static_assert(rfl::always_false_v<Type>, "Unsupported type");
         }
+        return error("'" + std::string(*_str) +
+                     "' is not a valid value for this enum.");
 
-      } catch (std::exception& e) {
-        return error(e.what());
+      } else {
+        static_assert(rfl::always_false_v<Type>, "Unsupported type");
       }
     }
   }
 
-  static std::optional<std::string> write(const T& _t) noexcept {
+  static Result<T> read_native(const RowBatch::Cell& _cell) noexcept
+    requires(std::is_arithmetic_v<Type> ||
+             (transpilation::has_reflection_method<Type> &&
+              has_read_native<
+                  std::remove_cvref_t<typename Type::ReflectionType>>))
+  {
     if constexpr (transpilation::has_reflection_method<Type>) {
-      return Parser<std::remove_cvref_t<typename Type::ReflectionType>>::write(
-          _t.reflection());
+      return Parser<std::remove_cvref_t<typename Type::ReflectionType>>::
+          read_native(_cell)
+              .transform([](auto&& _t) { return Type(std::move(_t)); });
+
+    } else {
+      switch (_cell.kind()) {
+        case RowBatch::Cell::Kind::int64:
+          return from_int64(_cell.int64());
+
+        case RowBatch::Cell::Kind::float64:
+          return from_float64(_cell.float64());
+
+        default:
+          return error("Expected a numeric value.");
+      }
+    }
+  }
+
+  /// Converts a native integer, making sure it fits into Type.
+  static Result<T> from_int64(const std::int64_t _val) noexcept
+    requires std::is_arithmetic_v<Type>
+  {
+    if constexpr (std::is_same_v<Type, bool>) {
+      return _val != 0;
+
+    } else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+      if (_val < std::numeric_limits<Type>::min() ||
+          _val > std::numeric_limits<Type>::max()) {
+        return error("Value '" + std::to_string(_val) + "' is out of range.");
+      }
+      return static_cast<Type>(_val);
+
+    } else if constexpr (std::is_integral_v<Type>) {
+      if (_val < 0 ||
+          static_cast<std::uint64_t>(_val) > std::numeric_limits<Type>::max()) {
+        return error("Value '" + std::to_string(_val) + "' is out of range.");
+      }
+      return static_cast<Type>(_val);
+
+    } else {
+      return static_cast<Type>(_val);
+    }
+  }
+
+  /// Converts a native floating point number, making sure it fits into
+  /// Type. Integers are truncated towards zero.
+  static Result<T> from_float64(const double _val) noexcept
+    requires std::is_arithmetic_v<Type>
+  {
+    const auto out_of_range = [&]() {
+      std::array<char, 32> buf{};
+      const auto [ptr, ec] =
+          std::to_chars(buf.data(), buf.data() + buf.size(), _val);
+      return error("Value '" + std::string(buf.data(), ptr) +
+                   "' is out of range.");
+    };
+
+    if constexpr (std::is_same_v<Type, bool>) {
+      return _val != 0.0;
+
+    } else if constexpr (std::is_integral_v<Type>) {
+      // Both bounds are powers of two (or zero), so they are exact.
+      constexpr auto lower =
+          static_cast<double>(std::numeric_limits<Type>::min());
+      constexpr auto upper =
+          2.0 * static_cast<double>(std::numeric_limits<Type>::max() / 2 + 1);
+      const auto truncated = std::trunc(_val);
+      // NaN fails both comparisons.
+      if (!(truncated >= lower && truncated < upper)) {
+        return out_of_range();
+      }
+      return static_cast<Type>(truncated);
+
+    } else {
+      if (std::isfinite(_val) &&
+          std::abs(_val) > std::numeric_limits<Type>::max()) {
+        return out_of_range();
+      }
+      return static_cast<Type>(_val);
+    }
+  }
+
+  template <class SinkType>
+  static void write(const T& _t, SinkType* _sink) noexcept {
+    if constexpr (transpilation::has_reflection_method<Type>) {
+      write_to(_t.reflection(), _sink);
+
     } else if constexpr (std::is_enum_v<Type>) {
-      return rfl::enum_to_string(_t);
+      constexpr auto enumerators = rfl::get_enumerator_array<Type>();
+      for (const auto& [name, value] : enumerators) {
+        if (value == _t) {
+          _sink->push_back(name);
+          return;
+        }
+      }
+      _sink->push_back(rfl::enum_to_string(_t));
+
+    } else if constexpr (std::is_floating_point_v<Type>) {
+      _sink->push_float64(static_cast<double>(_t));
+
+    } else if constexpr (std::is_unsigned_v<Type> &&
+                         sizeof(Type) == sizeof(std::int64_t)) {
+      // Values that do not fit into an int64_t are passed as text.
+      if (_t > static_cast<Type>(std::numeric_limits<std::int64_t>::max())) {
+        std::array<char, 24> buf{};
+        const auto [ptr, ec] =
+            std::to_chars(buf.data(), buf.data() + buf.size(), _t);
+        const auto len = static_cast<size_t>(ptr - buf.data());
+        _sink->push_back(std::string_view(buf.data(), len));
+      } else {
+        _sink->push_int64(static_cast<std::int64_t>(_t));
+      }
+
     } else {
-      return std::to_string(_t);
+      _sink->push_int64(static_cast<std::int64_t>(_t));
     }
   }
 
@@ -2,13 +2,17 @@
 #define SQLGEN_PARSING_PARSER_FOREIGN_KEY_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../ForeignKey.hpp"
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
 #include "../dynamic/Type.hpp"
 #include "../transpilation/get_tablename.hpp"
 #include "Parser_base.hpp"
+#include "has_read_native.hpp"
+#include "write_to.hpp"
 
 namespace sqlgen::parsing {
 
@@ -16,15 +20,26 @@ template <class T, class _ForeignTableType,
           rfl::internal::StringLiteral _col_name>
 struct Parser<ForeignKey<T, _ForeignTableType, _col_name>> {
   static Result<ForeignKey<T, _ForeignTableType, _col_name>> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     return Parser<std::remove_cvref_t<T>>::read(_str).transform([](auto&& _t) {
       return ForeignKey<T, _ForeignTableType, _col_name>(std::move(_t));
     });
   }
 
-  static std::optional<std::string> write(
-      const ForeignKey<T, _ForeignTableType, _col_name>& _f) noexcept {
-    return Parser<std::remove_cvref_t<T>>::write(_f.value());
+  static Result<ForeignKey<T, _ForeignTableType, _col_name>> read_native(
+      const RowBatch::Cell& _cell) noexcept
+    requires has_read_native<std::remove_cvref_t<T>>
+  {
+    return Parser<std::remove_cvref_t<T>>::read_native(_cell).transform(
+        [](auto&& _t) {
+          return ForeignKey<T, _ForeignTableType, _col_name>(std::move(_t));
+        });
+  }
+
+  template <class SinkType>
+  static void write(const ForeignKey<T, _ForeignTableType, _col_name>& _f,
+                    SinkType* _sink) noexcept {
+    write_to(_f.value(), _sink);
   }
 
   static dynamic::Type to_type() noexcept {
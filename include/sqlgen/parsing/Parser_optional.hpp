@@ -3,18 +3,22 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
 #include "../dynamic/Type.hpp"
 #include "Parser_base.hpp"
+#include "has_read_native.hpp"
+#include "write_to.hpp"
 
 namespace sqlgen::parsing {
 
 template <class T>
 struct Parser<std::optional<T>> {
   static Result<std::optional<T>> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     if (!_str) {
       return std::optional<T>();
     }
@@ -24,11 +28,23 @@ struct Parser<std::optional<T>> {
         });
   }
 
-  static std::optional<std::string> write(const std::optional<T>& _o) noexcept {
+  static Result<std::optional<T>> read_native(
+      const RowBatch::Cell& _cell) noexcept
+    requires has_read_native<std::remove_cvref_t<T>>
+  {
+    return Parser<std::remove_cvref_t<T>>::read_native(_cell).transform(
+        [](auto&& _t) -> std::optional<T> {
+          return std::make_optional<T>(std::move(_t));
+        });
+  }
+
+  template <class SinkType>
+  static void write(const std::optional<T>& _o, SinkType* _sink) noexcept {
     if (!_o) {
-      return std::nullopt;
+      _sink->push_null();
+      return;
     }
-    return Parser<std::remove_cvref_t<T>>::write(*_o);
+    write_to(*_o, _sink);
   }
 
   static dynamic::Type to_type() noexcept {
@@ -2,31 +2,46 @@
 #define SQLGEN_PARSING_PARSER_PRIMARY_KEY_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../PrimaryKey.hpp"
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
 #include "../dynamic/Type.hpp"
 #include "Parser_base.hpp"
+#include "has_read_native.hpp"
+#include "write_to.hpp"
 
 namespace sqlgen::parsing {
 
 template <class T, bool _auto_incr>
 struct Parser<PrimaryKey<T, _auto_incr>> {
   static Result<PrimaryKey<T, _auto_incr>> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     return Parser<std::remove_cvref_t<T>>::read(_str).transform(
         [](auto&& _t) -> PrimaryKey<T, _auto_incr> {
           return PrimaryKey<T, _auto_incr>(std::move(_t));
         });
   }
 
-  static std::optional<std::string> write(
-      const PrimaryKey<T, _auto_incr>& _p) noexcept {
+  static Result<PrimaryKey<T, _auto_incr>> read_native(
+      const RowBatch::Cell& _cell) noexcept
+    requires has_read_native<std::remove_cvref_t<T>>
+  {
+    return Parser<std::remove_cvref_t<T>>::read_native(_cell).transform(
+        [](auto&& _t) -> PrimaryKey<T, _auto_incr> {
+          return PrimaryKey<T, _auto_incr>(std::move(_t));
+        });
+  }
+
+  template <class SinkType>
+  static void write(const PrimaryKey<T, _auto_incr>& _p,
+                    SinkType* _sink) noexcept {
     if constexpr (_auto_incr) {
-      return std::nullopt;
+      _sink->push_null();
     } else {
-      return Parser<std::remove_cvref_t<T>>::write(_p.value());
+      write_to(_p.value(), _sink);
     }
   }
 
@@ -3,18 +3,22 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
 #include "../dynamic/Type.hpp"
 #include "Parser_base.hpp"
+#include "has_read_native.hpp"
+#include "write_to.hpp"
 
 namespace sqlgen::parsing {
 
 template <class T>
 struct Parser<std::shared_ptr<T>> {
   static Result<std::shared_ptr<T>> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     if (!_str) {
       return std::shared_ptr<T>();
     }
@@ -24,12 +28,23 @@ struct Parser<std::shared_ptr<T>> {
         });
   }
 
-  static std::optional<std::string> write(
-      const std::shared_ptr<T>& _ptr) noexcept {
+  static Result<std::shared_ptr<T>> read_native(
+      const RowBatch::Cell& _cell) noexcept
+    requires has_read_native<std::remove_cvref_t<T>>
+  {
+    return Parser<std::remove_cvref_t<T>>::read_native(_cell).transform(
+        [](auto&& _t) -> std::shared_ptr<T> {
+          return std::make_shared<T>(std::move(_t));
+        });
+  }
+
+  template <class SinkType>
+  static void write(const std::shared_ptr<T>& _ptr, SinkType* _sink) noexcept {
     if (!_ptr) {
-      return std::nullopt;
+      _sink->push_null();
+      return;
     }
-    return Parser<std::remove_cvref_t<T>>::write(*_ptr);
+    write_to(*_ptr, _sink);
   }
 
   static dynamic::Type to_type() noexcept {
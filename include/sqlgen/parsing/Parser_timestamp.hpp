@@ -1,13 +1,21 @@
 #ifndef SQLGEN_PARSING_PARSER_TIMESTAMP_HPP_
 #define SQLGEN_PARSING_PARSER_TIMESTAMP_HPP_
 
+#include <algorithm>
+#include <array>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
 #include "../Timestamp.hpp"
 #include "../dynamic/Type.hpp"
 #include "../dynamic/types.hpp"
+#include "../internal/format_timestamp.hpp"
+#include "../internal/microseconds_to_tm.hpp"
+#include "../internal/parse_timestamp.hpp"
+#include "../internal/timestamp_layout.hpp"
 #include "Parser_base.hpp"
 
 namespace sqlgen::parsing {
@@ -16,15 +24,51 @@ template <rfl::internal::StringLiteral _format>
 struct Parser<Timestamp<_format>> {
   using TSType = Timestamp<_format>;
 
-  static Result<TSType> read(const std::optional<std::string>& _str) noexcept {
-    return Parser<std::string>::read(_str).and_then(
-        [](auto&& _s) -> Result<TSType> {
-          return TSType::from_string(std::move(_s));
-        });
+  /// Common formats, such as Date and DateTime, are parsed and formatted at
+  /// fixed offsets instead of going through strptime and strftime.
+  static constexpr internal::TimestampLayout layout =
+      internal::to_timestamp_layout(
+          std::string_view(_format.arr_.data(), _format.arr_.size() - 1));
+
+  static Result<TSType> read(
+      const std::optional<std::string_view>& _str) noexcept {
+    if (!_str) {
+      return error("NULL value encounted: Timestamp value cannot be NULL.");
+    }
+    if constexpr (layout.value != internal::TimestampLayout::Value::other) {
+      const auto tm = internal::parse_timestamp(*_str, layout);
+      if (tm) {
+        return TSType(*tm);
+      }
+    }
+    // Timestamps are short, so we can usually avoid the heap allocation of a
+    // NUL-terminated copy.
+    std::array<char, 64> buf{};
+    if (_str->size() < buf.size()) {
+      std::copy(_str->begin(), _str->end(), buf.begin());
+      return TSType::from_string(buf.data());
+    }
+    return TSType::from_string(std::string(*_str));
   }
 
-  static std::optional<std::string> write(const TSType& _t) noexcept {
-    return Parser<std::string>::write(_t.str());
+  static Result<TSType> read_native(const RowBatch::Cell& _cell) noexcept {
+    if (_cell.kind() != RowBatch::Cell::Kind::timestamp) {
+      return error("Expected a timestamp.");
+    }
+    return TSType(internal::microseconds_to_tm(_cell.timestamp()));
+  }
+
+  template <class SinkType>
+  static void write(const TSType& _t, SinkType* _sink) noexcept {
+    if constexpr (layout.value != internal::TimestampLayout::Value::other) {
+      std::array<char, 32> buf{};
+      const auto str = internal::format_timestamp(_t.tm(), layout, &buf);
+      if (str) {
+        _sink->push_back(*str);
+        return;
+      }
+    }
+    _sink->push_back(_t.str());
   }
 
   static dynamic::Type to_type() noexcept {
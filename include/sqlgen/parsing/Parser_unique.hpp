@@ -2,25 +2,37 @@
 #define SQLGEN_PARSING_PARSER_UNIQUE_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
 #include "../Unique.hpp"
 #include "../dynamic/Type.hpp"
 #include "Parser_base.hpp"
+#include "has_read_native.hpp"
+#include "write_to.hpp"
 
 namespace sqlgen::parsing {
 
 template <class T>
 struct Parser<Unique<T>> {
   static Result<Unique<T>> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     return Parser<std::remove_cvref_t<T>>::read(_str).transform(
         [](auto&& _t) { return Unique<T>(std::move(_t)); });
   }
 
-  static std::optional<std::string> write(const Unique<T>& _f) noexcept {
-    return Parser<std::remove_cvref_t<T>>::write(_f.value());
+  static Result<Unique<T>> read_native(const RowBatch::Cell& _cell) noexcept
+    requires has_read_native<std::remove_cvref_t<T>>
+  {
+    return Parser<std::remove_cvref_t<T>>::read_native(_cell).transform(
+        [](auto&& _t) { return Unique<T>(std::move(_t)); });
+  }
+
+  template <class SinkType>
+  static void write(const Unique<T>& _f, SinkType* _sink) noexcept {
+    write_to(_f.value(), _sink);
   }
 
   static dynamic::Type to_type() noexcept {
@@ -2,6 +2,7 @@
 #define SQLGEN_PARSING_PARSER_VARCHAR_HPP_
 
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "../Result.hpp"
@@ -15,15 +16,22 @@ namespace sqlgen::parsing {
 template <size_t _size>
 struct Parser<Varchar<_size>> {
   static Result<Varchar<_size>> read(
-      const std::optional<std::string>& _str) noexcept {
-    return Parser<std::string>::read(_str).and_then(
-        [](auto&& _t) -> Result<Varchar<_size>> {
-          return Varchar<_size>::make(std::move(_t));
-        });
+      const std::optional<std::string_view>& _str) noexcept {
+    if (!_str) {
+      return error("NULL value encounted: String value cannot be NULL.");
+    }
+    if (_str->size() > _size) {
+      return error("String '" + std::string(*_str) +
+                   "' too long: " + std::to_string(_str->size()) +
+                   " exceeds the maximum length of " + std::to_string(_size) +
+                   ".");
+    }
+    return Varchar<_size>(std::string(*_str));
   }
 
-  static std::optional<std::string> write(const Varchar<_size>& _v) noexcept {
-    return Parser<std::string>::write(_v.value());
+  template <class SinkType>
+  static void write(const Varchar<_size>& _v, SinkType* _sink) noexcept {
+    _sink->push_back(_v.value());
   }
 
   static dynamic::Type to_type() noexcept {
@@ -0,0 +1,21 @@
+#ifndef SQLGEN_PARSING_HAS_READ_NATIVE_HPP_
+#define SQLGEN_PARSING_HAS_READ_NATIVE_HPP_
+
+#include <concepts>
+
+#include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "Parser_base.hpp"
+
+namespace sqlgen::parsing {
+
+/// Whether Parser<T> can read native cells (integers, floating point values)
+/// directly, without formatting them as text first.
+template <class T>
+concept has_read_native = requires(const RowBatch::Cell& _cell) {
+  { Parser<T>::read_native(_cell) } -> std::same_as<Result<T>>;
+};
+
+}  // namespace sqlgen::parsing
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef SQLGEN_PARSING_PARSE_NUMBER_HPP_
+#define SQLGEN_PARSING_PARSE_NUMBER_HPP_
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "../Result.hpp"
+
+namespace sqlgen::parsing {
+
+/// Parses a number using std::from_chars, so there are no allocations, no
+/// locale lookups and no exceptions. Like std::stoll, leading whitespace and
+/// a leading '+' are skipped and parsing stops at the first character that
+/// is not part of the number.
+template <class T>
+Result<T> parse_number(const std::string_view _str) noexcept {
+  auto begin = _str.data();
+  const auto end = _str.data() + _str.size();
+
+  while (begin != end && (*begin == ' ' || *begin == '\t' || *begin == '\n' ||
+                          *begin == '\r')) {
+    ++begin;
+  }
+
+  if (begin != end && *begin == '+') {
+    ++begin;
+  }
+
+  T val{};
+
+  const auto [ptr, ec] = std::from_chars(begin, end, val);
+
+  if (ec == std::errc::result_out_of_range) {
+    return error("Value '" + std::string(_str) + "' is out of range.");
+  }
+
+  if (ec != std::errc()) {
+    return error("Could not parse '" + std::string(_str) + "' as a number.");
+  }
+
+  return val;
+}
+
+}  // namespace sqlgen::parsing
+
+#endif
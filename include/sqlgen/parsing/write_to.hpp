@@ -0,0 +1,30 @@
+#ifndef SQLGEN_PARSING_WRITE_TO_HPP_
+#define SQLGEN_PARSING_WRITE_TO_HPP_
+
+#include <type_traits>
+
+#include "Parser_base.hpp"
+
+namespace sqlgen::parsing {
+
+/// Appends _val to _sink, which is usually a RowBatch. Parsers that do not
+/// support sinks and return std::optional<std::string> from write(...)
+/// instead are supported as well.
+template <class T, class SinkType>
+void write_to(const T& _val, SinkType* _sink) {
+  using Type = std::remove_cvref_t<T>;
+  if constexpr (requires { Parser<Type>::write(_val, _sink); }) {
+    Parser<Type>::write(_val, _sink);
+  } else {
+    const auto str = Parser<Type>::write(_val);
+    if (str) {
+      _sink->push_back(*str);
+    } else {
+      _sink->push_null();
+    }
+  }
+}
+
+}  // namespace sqlgen::parsing
+
+#endif
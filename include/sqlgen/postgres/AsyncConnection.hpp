@@ -0,0 +1,104 @@
+#ifndef SQLGEN_POSTGRES_ASYNCCONNECTION_HPP_
+#define SQLGEN_POSTGRES_ASYNCCONNECTION_HPP_
+
+#include <libpq-fe.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../IteratorBase.hpp"
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../Task.hpp"
+#include "../dynamic/Statement.hpp"
+#include "../is_async_connection.hpp"
+#include "Credentials.hpp"
+#include "EventLoop.hpp"
+#include "to_sql.hpp"
+
+namespace sqlgen::postgres {
+
+/// A connection that never blocks the calling thread. Every operation
+/// returns a task, which sends the query using the non-blocking API of
+/// libpq and suspends until the socket is ready, so that a single thread
+/// running an EventLoop can have many queries in flight on many
+/// connections.
+///
+/// Only one task can use a connection at a time. The connection and the
+/// event loop must outlive all tasks using them. Results are received in
+/// full before they are returned, in the text format. There is no
+/// asynchronous counterpart to .insert(...) or to the COPY used by
+/// .write(...).
+class AsyncConnection {
+  using ConnPtr = Ref<PGconn>;
+
+ public:
+  AsyncConnection(const ConnPtr& _conn, EventLoop* _loop)
+      : conn_(_conn), loop_(_loop) {}
+
+  /// Connects to the server without blocking the event loop.
+  static Task<Result<Ref<AsyncConnection>>> connect(
+      EventLoop* _loop, const Credentials _credentials);
+
+  ~AsyncConnection() = default;
+
+  Task<Result<Nothing>> begin_transaction() {
+    return execute("BEGIN TRANSACTION;");
+  }
+
+  Task<Result<Nothing>> commit() { return execute("COMMIT;"); }
+
+  /// Executes _sql, which may contain more than one statement.
+  Task<Result<Nothing>> execute(const std::string _sql);
+
+  /// Executes _sql, binding the values in the first row of _params to its
+  /// parameters.
+  Task<Result<Nothing>> execute(const std::string _sql,
+                                const RowBatch _params);
+
+  /// Whether the connection to the server is still usable.
+  bool is_alive() const noexcept {
+    return PQstatus(conn_.get()) == CONNECTION_OK;
+  }
+
+  /// Reads the results of the SELECT statement _sql, binding the values in
+  /// the first row of _params to its parameters.
+  Task<Result<Ref<IteratorBase>>> read(const std::string _sql,
+                                       const RowBatch _params);
+
+  Task<Result<Nothing>> rollback() { return execute("ROLLBACK;"); }
+
+  std::string to_sql(const dynamic::Statement& _stmt) noexcept {
+    return postgres::to_sql_impl(_stmt);
+  }
+
+ private:
+  /// Sends _sql, binding _params, unless it is std::nullopt, and receives
+  /// the result.
+  Task<Result<Ref<PGresult>>> query(
+      const std::string _sql,
+      const std::optional<std::vector<std::optional<std::string>>> _params);
+
+  /// Waits until all of the query has been sent to the server.
+  Task<Result<Nothing>> flush();
+
+  /// Receives all results of the query that has been sent. Returns the
+  /// first error or the last result.
+  Task<Result<Ref<PGresult>>> receive(const std::string _sql);
+
+ private:
+  /// The underlying postgres connection, in non-blocking mode.
+  ConnPtr conn_;
+
+  /// The event loop resuming the tasks.
+  EventLoop* loop_;
+};
+
+static_assert(is_async_connection<AsyncConnection>,
+              "Must fulfill the is_async_connection concept.");
+
+}  // namespace sqlgen::postgres
+
+#endif
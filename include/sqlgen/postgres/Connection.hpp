@@ -4,17 +4,22 @@
 #include <libpq-fe.h>
 
 #include <memory>
+#include <optional>
 #include <rfl.hpp>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "../IteratorBase.hpp"
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../StatementCacheStats.hpp"
 #include "../Transaction.hpp"
 #include "../dynamic/Column.hpp"
 #include "../dynamic/Statement.hpp"
 #include "../dynamic/Write.hpp"
+#include "../internal/StatementCache.hpp"
 #include "../is_connection.hpp"
 #include "Credentials.hpp"
 #include "exec.hpp"
@@ -25,9 +30,25 @@ namespace sqlgen::postgres {
 class Connection {
   using ConnPtr = Ref<PGconn>;
 
+  /// The maximum number of queries sent in pipeline mode before waiting for
+  /// the results. Keeps the amount of unread results small enough to not
+  /// block the server.
+  static constexpr size_t pipeline_depth_ = 1000;
+
+  /// The maximum number of parameters PostgreSQL accepts in a single
+  /// statement. Determines how many rows a single INSERT can insert.
+  static constexpr size_t max_params_ = 65535;
+
  public:
   Connection(const Credentials& _credentials)
-      : conn_(make_conn(_credentials.to_str())), credentials_(_credentials) {}
+      : conn_(make_conn(_credentials.to_str())),
+        credentials_(_credentials),
+        num_stmts_(0),
+        stale_stmts_(std::make_shared<std::vector<std::string>>()),
+        stmt_cache_(_credentials.statement_cache_size,
+                     [stale = stale_stmts_](const std::string& _name) {
+                       stale->push_back(_name);
+                     }) {}
 
   static rfl::Result<Ref<Connection>> make(
       const Credentials& _credentials) noexcept;
@@ -42,38 +63,152 @@ class Connection {
     return exec(conn_, _sql).transform([](auto&&) { return Nothing{}; });
   }
 
-  Result<Nothing> insert(
-      const dynamic::Insert& _stmt,
-      const std::vector<std::vector<std::optional<std::string>>>&
-          _data) noexcept;
+  /// Executes _sql as a prepared statement, binding the values in the
+  /// first row of _params to its parameters.
+  Result<Nothing> execute(const std::string& _sql,
+                          const RowBatch& _params) noexcept;
+
+  /// Executes all statements in _sqls in pipeline mode, which means that
+  /// we do not wait for the result of one statement before sending the next
+  /// one. Each string must contain a single statement. Stops at the first
+  /// statement that fails.
+  Result<Nothing> execute_many(const std::vector<std::string>& _sqls) noexcept;
+
+  Result<Nothing> insert(const dynamic::Insert& _stmt,
+                         const RowBatch& _data) noexcept;
+
+  /// Whether the connection to the server is still usable. This is cheap,
+  /// because it does not contact the server, but only reflects the outcome
+  /// of the last operation.
+  bool is_alive() const noexcept {
+    return PQstatus(conn_.get()) == CONNECTION_OK;
+  }
 
   Result<Ref<IteratorBase>> read(const dynamic::SelectFrom& _query);
 
+  /// Reads the results of the SELECT statement _sql, binding the values in
+  /// the first row of _params to its parameters. If there are parameters,
+  /// the results are streamed in ReadMode::copy, because COPY does not
+  /// accept parameters.
+  Result<Ref<IteratorBase>> read(const std::string& _sql,
+                                 const RowBatch& _params);
+
   Result<Nothing> rollback() noexcept;
 
+  /// Formats the values in the first row of _params as text, as expected
+  /// by libpq.
+  static Result<std::vector<std::optional<std::string>>> to_params(
+      const RowBatch& _params) noexcept;
+
   std::string to_sql(const dynamic::Statement& _stmt) noexcept {
     return postgres::to_sql_impl(_stmt);
   }
 
-  Result<Nothing> start_write(const dynamic::Write& _stmt) {
-    return execute(postgres::to_sql_impl(_stmt));
+  Result<Nothing> start_write(const dynamic::Write& _stmt);
+
+  /// The number of hits and misses of the prepared statement cache.
+  StatementCacheStats statement_cache_stats() const noexcept {
+    return stmt_cache_.stats();
   }
 
   Result<Nothing> end_write();
 
-  Result<Nothing> write(
-      const std::vector<std::vector<std::optional<std::string>>>& _data);
+  /// The number of chunks sent by the current or most recent write
+  /// operation.
+  size_t num_copy_chunks() const noexcept { return num_copy_chunks_; }
+
+  Result<Nothing> write(const RowBatch& _data);
 
  private:
+  /// Aborts the ongoing COPY with _msg as the error message, so that none of
+  /// the rows are written, and discards its results.
+  void abort_copy(const std::string& _msg) noexcept;
+
+  /// Deallocates the prepared statements that have been evicted from the
+  /// cache. The names of the statements that could not be deallocated are
+  /// kept, so that this is retried the next time.
+  Result<Nothing> deallocate_stale_statements() noexcept;
+
+  /// Sends the rows serialized into copy_buffer_ to the server, without
+  /// waiting for them to be transmitted.
+  Result<Nothing> flush_copy_buffer() noexcept;
+
+  /// Returns the name of the prepared statement for _sql from the cache,
+  /// preparing it if necessary.
+  Result<std::string> get_statement(const std::string& _sql,
+                                    const int _num_params) noexcept;
+
+  /// Retrieves the types of the columns written to by _stmt.
+  Result<std::vector<Oid>> get_column_types(
+      const dynamic::Write& _stmt) noexcept;
+
   static ConnPtr make_conn(const std::string& _conn_str);
 
-  std::string to_buffer(
-      const std::vector<std::optional<std::string>>& _line) const noexcept;
+  /// Sends a synchronization point and collects the results of all queries
+  /// sent in pipeline mode since the last one.
+  Result<Nothing> sync_pipeline() noexcept;
+
+  /// Reads the results of _sql as a prepared statement, binding _params.
+  Result<Ref<IteratorBase>> read_with_params(const std::string& _sql,
+                                             const RowBatch& _params);
+
+  /// The indices of the rows in _data that need to be inserted by _stmt.
+  /// PostgreSQL rejects an ON CONFLICT DO UPDATE statement that affects the
+  /// same row twice, so only the last row with a given key is kept.
+  static std::vector<size_t> rows_to_insert(const dynamic::Insert& _stmt,
+                                            const RowBatch& _data);
+
+  /// Appends a line in the format expected by COPY to _buffer.
+  Result<Nothing> to_buffer(const RowBatch::Row& _row,
+                            std::string* _buffer) const noexcept;
+
+  /// Appends a tuple in the binary format expected by COPY to _buffer.
+  Result<Nothing> to_binary_buffer(const RowBatch::Row& _row,
+                                   std::string* _buffer) const noexcept;
+
+  /// Returns the name of the prepared statement for _sql, like
+  /// get_statement(...), and deallocates the statements that have been
+  /// evicted. If the cache is disabled, the statement is deallocated the
+  /// next time this is called.
+  Result<std::string> use_statement(const std::string& _sql,
+                                    const size_t _num_params) noexcept;
+
+  /// Blocks until all data passed to libpq has been transmitted.
+  Result<Nothing> wait_until_sent() noexcept;
 
  private:
   ConnPtr conn_;
 
+  /// Whether the ongoing COPY has been aborted by .write(...), in which case
+  /// .end_write() has nothing left to do.
+  bool copy_aborted_ = false;
+
+  /// The types of the columns currently written to, if COPY uses the binary
+  /// format. Empty, if it uses the text format.
+  std::vector<Oid> copy_types_;
+
+  /// The rows are serialized into this buffer before they are sent using
+  /// COPY. Reused for all chunks.
+  std::string copy_buffer_;
+
+  /// The number of chunks sent by the current or most recent write
+  /// operation.
+  size_t num_copy_chunks_ = 0;
+
   Credentials credentials_;
+
+  /// The number of statements prepared so far, used to generate unique
+  /// names.
+  size_t num_stmts_;
+
+  /// The names of prepared statements that have been evicted from the
+  /// cache, but not deallocated yet. They might still be used by the
+  /// ongoing insert, or deallocating them might have failed.
+  std::shared_ptr<std::vector<std::string>> stale_stmts_;
+
+  /// Maps the SQL of the most recently used prepared statements to their
+  /// names.
+  internal::StatementCache<std::string> stmt_cache_;
 };
 
 static_assert(is_connection<Connection>,
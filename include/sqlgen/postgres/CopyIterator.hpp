@@ -0,0 +1,104 @@
+#ifndef SQLGEN_POSTGRES_COPYITERATOR_HPP_
+#define SQLGEN_POSTGRES_COPYITERATOR_HPP_
+
+#include <libpq-fe.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../IteratorBase.hpp"
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../dynamic/Type.hpp"
+
+namespace sqlgen::postgres {
+
+/// Runs the query as COPY (...) TO STDOUT and parses the rows as they
+/// arrive, in the binary or the text format. This is the fastest way to
+/// export large results, but like StreamingIterator, the connection cannot
+/// be used for anything else until all rows have been read or the iterator
+/// has been destroyed.
+class CopyIterator : public sqlgen::IteratorBase {
+  using ConnPtr = Ref<PGconn>;
+
+ public:
+  CopyIterator(const std::string& _sql, const ConnPtr& _conn,
+               const bool _binary = false);
+
+  CopyIterator(const CopyIterator& _other) = delete;
+
+  ~CopyIterator();
+
+  /// Whether the end of the available data has been reached.
+  bool end() const final;
+
+  /// Returns the next batch of rows.
+  /// If _batch_size is greater than the number of rows left, returns all
+  /// of the rows left.
+  Result<RowBatch> next(const size_t _batch_size) final;
+
+  /// Columns holding enums are accepted in the binary format, even though
+  /// their OIDs are not known in advance.
+  void set_column_types(const std::vector<dynamic::Type>& _types) final;
+
+  CopyIterator& operator=(const CopyIterator& _other) = delete;
+
+ private:
+  /// Reads the final result of the COPY and discards everything after it.
+  Result<Nothing> finish() noexcept;
+
+  /// Parses the tuples in a message of the binary format.
+  Result<Nothing> parse_binary(std::string_view _msg, RowBatch* _batch);
+
+  /// Parses a line of the text format.
+  Result<Nothing> parse_text(std::string_view _msg, RowBatch* _batch);
+
+  /// Sends the COPY statement.
+  Result<Nothing> send() noexcept;
+
+  /// Cancels the COPY, if it is still running outside of a transaction
+  /// block, and discards the rest of the data.
+  void shutdown() noexcept;
+
+ private:
+  /// The underlying postgres connection. We have this in here to prevent its
+  /// destruction for the lifetime of the iterator.
+  ConnPtr conn_;
+
+  /// Whether the end is reached.
+  bool end_;
+
+  /// Whether the rows are received in the binary format.
+  bool binary_;
+
+  /// Whether the header of the binary format has been parsed.
+  bool header_parsed_;
+
+  /// Whether the COPY was sent inside a transaction block, in which case it
+  /// must not be cancelled.
+  bool in_transaction_;
+
+  /// Whether the columns are expected to hold enums.
+  std::vector<bool> is_enum_;
+
+  /// The OIDs of the column types of the query.
+  std::vector<Oid> oids_;
+
+  /// Whether all data has been received.
+  bool received_all_;
+
+  /// Whether the COPY statement has been sent.
+  bool sent_;
+
+  /// The query, without the trailing semicolon.
+  std::string sql_;
+
+  /// Holds unescaped values of the text format.
+  std::string unescaped_;
+};
+
+}  // namespace sqlgen::postgres
+
+#endif
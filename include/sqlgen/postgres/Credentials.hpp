@@ -1,10 +1,28 @@
 #ifndef SQLGEN_POSTGRES_CREDENTIALS_HPP_
 #define SQLGEN_POSTGRES_CREDENTIALS_HPP_
 
+#include <cstddef>
 #include <string>
 
 namespace sqlgen::postgres {
 
+/// How query results are read from the server.
+enum class ReadMode {
+  /// Declares a cursor and fetches one batch per round trip. The connection
+  /// can be used for other queries in between.
+  cursor,
+
+  /// Sends the query once and receives the rows as they arrive. This saves
+  /// several round trips, but the connection is busy until all rows have
+  /// been read.
+  stream,
+
+  /// Runs the query as COPY (...) TO STDOUT, which is the fastest way to
+  /// export large results. Like stream, the connection is busy until all
+  /// rows have been read.
+  copy
+};
+
 struct Credentials {
   std::string user;
   std::string password;
@@ -12,6 +30,30 @@ struct Credentials {
   std::string dbname;
   int port = 5432;
 
+  /// Whether query results should be fetched in the binary format. This
+  /// avoids formatting and parsing numbers and timestamps as text. Queries
+  /// returning types that cannot be decoded from the binary format (such as
+  /// NUMERIC) fall back to the text format.
+  bool binary_results = false;
+
+  /// Whether .write(...) should send the rows using COPY in the binary
+  /// format. This avoids formatting the values as text on the client and
+  /// parsing them on the server. Tables containing columns of types that
+  /// cannot be encoded in the binary format (such as NUMERIC) fall back to
+  /// the text format.
+  bool binary_copy = false;
+
+  /// The number of bytes .write(...) serializes before sending them to the
+  /// server in a single chunk.
+  size_t copy_buffer_size = 4 * 1024 * 1024;
+
+  /// The number of prepared statements kept per connection. Set it to 0 to
+  /// disable the cache.
+  size_t statement_cache_size = 100;
+
+  /// How query results are read from the server.
+  ReadMode read_mode = ReadMode::cursor;
+
   std::string to_str() const {
     return "postgresql://" + user + ":" + password + "@" + host + ":" +
            std::to_string(port) + "/" + dbname;
@@ -0,0 +1,131 @@
+#ifndef SQLGEN_POSTGRES_EVENTLOOP_HPP_
+#define SQLGEN_POSTGRES_EVENTLOOP_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../Result.hpp"
+#include "../Task.hpp"
+
+namespace sqlgen::postgres {
+
+/// A single-threaded event loop, which resumes coroutines once the socket
+/// they are waiting for is ready. Many AsyncConnections can share the same
+/// loop, so that a single thread can wait for the results of many queries at
+/// the same time. Not thread-safe.
+class EventLoop {
+ public:
+  /// What a coroutine is waiting for.
+  enum class Interest { read, write, read_or_write };
+
+  /// Suspends the awaiting coroutine until _fd is ready.
+  struct Awaiter {
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(const std::coroutine_handle<> _handle) noexcept {
+      handle_ = _handle;
+      return loop_->add(this);
+    }
+
+    /// Returns an error, if the socket could not be watched.
+    Result<Nothing> await_resume() const noexcept {
+      if (err_) {
+        return error(*err_);
+      }
+      return Nothing{};
+    }
+
+    EventLoop* loop_;
+
+    int fd_;
+
+    Interest interest_;
+
+    std::coroutine_handle<> handle_ = nullptr;
+
+    std::optional<std::string> err_ = std::nullopt;
+  };
+
+  EventLoop() = default;
+
+  EventLoop(const EventLoop& _other) = delete;
+
+  ~EventLoop();
+
+  /// The number of coroutines currently waiting for a socket.
+  size_t num_waiting() const noexcept { return waiting_.size(); }
+
+  /// Runs until all tasks passed to .spawn(...) have finished. If any of
+  /// them threw an exception, the exception of the first one spawned is
+  /// rethrown.
+  void run();
+
+  /// Starts _task and runs until it has finished. Returns its result.
+  template <class T>
+  T run(Task<T> _task) {
+    _task.start();
+    while (!_task.done()) {
+      run_once();
+    }
+    return _task.result();
+  }
+
+  /// Starts _task, which keeps running in the background while the loop is
+  /// running. Its result is discarded, but exceptions are rethrown by
+  /// .run().
+  template <class T>
+  void spawn(Task<T> _task) {
+    auto task = std::make_shared<Task<T>>(std::move(_task));
+    task->start();
+    tasks_.emplace_back(Spawned{
+        .task = std::move(task),
+        .exception = [](const void* _ptr) noexcept -> std::exception_ptr {
+          const auto t = static_cast<const Task<T>*>(_ptr);
+          return t->done() ? t->exception() : nullptr;
+        }});
+  }
+
+  /// Suspends the awaiting coroutine until _fd is ready for _interest.
+  Awaiter wait(const int _fd, const Interest _interest) noexcept {
+    return Awaiter{.loop_ = this, .fd_ = _fd, .interest_ = _interest};
+  }
+
+  EventLoop& operator=(const EventLoop& _other) = delete;
+
+ private:
+  /// A task passed to .spawn(...), with its type erased.
+  struct Spawned {
+    /// Keeps the task alive.
+    std::shared_ptr<void> task;
+
+    /// Returns the exception thrown by the task, if it has finished.
+    std::exception_ptr (*exception)(const void*) noexcept;
+  };
+
+ private:
+  /// Starts watching the socket of _awaiter. Returns false, if that fails,
+  /// in which case the coroutine is not suspended.
+  bool add(Awaiter* _awaiter) noexcept;
+
+  /// Waits for at least one socket to become ready and resumes the
+  /// coroutines waiting for them.
+  void run_once();
+
+ private:
+  /// The coroutines currently waiting for a socket.
+  std::vector<Awaiter*> waiting_;
+
+  /// The tasks passed to .spawn(...), which are kept alive until .run()
+  /// returns.
+  std::vector<Spawned> tasks_;
+};
+
+}  // namespace sqlgen::postgres
+
+#endif
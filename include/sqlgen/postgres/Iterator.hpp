@@ -11,6 +11,8 @@
 #include "../IteratorBase.hpp"
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../dynamic/Type.hpp"
 #include "Connection.hpp"
 
 namespace sqlgen::postgres {
@@ -19,7 +21,11 @@ class Iterator : public sqlgen::IteratorBase {
   using ConnPtr = Ref<PGconn>;
 
  public:
-  Iterator(const std::string& _sql, const ConnPtr& _conn);
+  /// Declares a cursor for _sql, binding _params to its parameters. NULL
+  /// values are represented by std::nullopt.
+  Iterator(const std::string& _sql, const ConnPtr& _conn,
+           const bool _binary = false,
+           const std::vector<std::optional<std::string>>& _params = {});
 
   Iterator(const Iterator& _other) = delete;
 
@@ -33,8 +39,11 @@ class Iterator : public sqlgen::IteratorBase {
   /// Returns the next batch of rows.
   /// If _batch_size is greater than the number of rows left, returns all
   /// of the rows left.
-  Result<std::vector<std::vector<std::optional<std::string>>>> next(
-      const size_t _batch_size) final;
+  Result<RowBatch> next(const size_t _batch_size) final;
+
+  /// Columns holding enums are accepted in the binary result format, even
+  /// though their OIDs are not known in advance.
+  void set_column_types(const std::vector<dynamic::Type>& _types) final;
 
   Iterator& operator=(const Iterator& _other) = delete;
 
@@ -46,6 +55,10 @@ class Iterator : public sqlgen::IteratorBase {
     return "sqlgen_cursor";
   }
 
+  /// Retrieves the column types of the cursor and falls back to the text
+  /// format, if any of them cannot be decoded from the binary format.
+  void describe();
+
   /// Shuts the iterator down.
   void shutdown();
 
@@ -59,6 +72,18 @@ class Iterator : public sqlgen::IteratorBase {
 
   /// Whether the end is reached.
   bool end_;
+
+  /// Whether the results are fetched in the binary format.
+  bool binary_;
+
+  /// Whether describe() has been called.
+  bool described_;
+
+  /// Whether the columns are expected to hold enums.
+  std::vector<bool> is_enum_;
+
+  /// The OIDs of the column types, as returned by describe().
+  std::vector<Oid> oids_;
 };
 
 }  // namespace sqlgen::postgres
@@ -0,0 +1,40 @@
+#ifndef SQLGEN_POSTGRES_RESULTITERATOR_HPP_
+#define SQLGEN_POSTGRES_RESULTITERATOR_HPP_
+
+#include <libpq-fe.h>
+
+#include "../IteratorBase.hpp"
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../RowBatch.hpp"
+
+namespace sqlgen::postgres {
+
+/// Iterates over the rows of a result that has already been received in
+/// full, in the text format. Used by AsyncConnection, which never blocks
+/// while the rows are read.
+class ResultIterator : public sqlgen::IteratorBase {
+ public:
+  ResultIterator(const Ref<PGresult>& _res);
+
+  ~ResultIterator() = default;
+
+  /// Whether the end of the available data has been reached.
+  bool end() const final;
+
+  /// Returns the next batch of rows.
+  /// If _batch_size is greater than the number of rows left, returns all
+  /// of the rows left.
+  Result<RowBatch> next(const size_t _batch_size) final;
+
+ private:
+  /// The result holding the rows.
+  Ref<PGresult> res_;
+
+  /// The index of the next row.
+  int row_ix_;
+};
+
+}  // namespace sqlgen::postgres
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef SQLGEN_POSTGRES_STREAMINGITERATOR_HPP_
+#define SQLGEN_POSTGRES_STREAMINGITERATOR_HPP_
+
+#include <libpq-fe.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../IteratorBase.hpp"
+#include "../Ref.hpp"
+#include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../dynamic/Type.hpp"
+
+namespace sqlgen::postgres {
+
+/// Sends the query once and receives the rows as they arrive, in chunks
+/// (libpq 17 and above) or row by row. Unlike Iterator, this does not need a
+/// cursor, but the connection cannot be used for anything else until all
+/// rows have been read or the iterator has been destroyed.
+class StreamingIterator : public sqlgen::IteratorBase {
+  using ConnPtr = Ref<PGconn>;
+  using ResultPtr = std::unique_ptr<PGresult, decltype(&PQclear)>;
+
+ public:
+  StreamingIterator(const std::string& _sql, const ConnPtr& _conn,
+                    const bool _binary = false);
+
+  /// Executes the statement prepared under _stmt_name, binding _params to
+  /// its parameters. NULL values are represented by std::nullopt.
+  StreamingIterator(const std::string& _stmt_name,
+                    const std::vector<std::optional<std::string>>& _params,
+                    const ConnPtr& _conn, const bool _binary = false);
+
+  StreamingIterator(const StreamingIterator& _other) = delete;
+
+  ~StreamingIterator();
+
+  /// Whether the end of the available data has been reached.
+  bool end() const final;
+
+  /// Returns the next batch of rows.
+  /// If _batch_size is greater than the number of rows left, returns all
+  /// of the rows left.
+  Result<RowBatch> next(const size_t _batch_size) final;
+
+  /// Columns holding enums are accepted in the binary result format, even
+  /// though their OIDs are not known in advance.
+  void set_column_types(const std::vector<dynamic::Type>& _types) final;
+
+  StreamingIterator& operator=(const StreamingIterator& _other) = delete;
+
+ private:
+  /// The maximum number of rows per result in chunked mode.
+  static constexpr int chunk_size_ = 1000;
+
+  /// Retrieves the column types of the prepared statement, so that we can
+  /// decide on the result format before sending the query.
+  void describe();
+
+  /// Discards all results that have not been read yet.
+  void drain() noexcept;
+
+  /// Receives the next result from the server.
+  Result<Nothing> receive() noexcept;
+
+  /// Sends the query and switches to chunked or single row mode.
+  Result<Nothing> send() noexcept;
+
+  /// Cancels the query, if it is still running outside of a transaction
+  /// block, and discards the rest of the results.
+  void shutdown() noexcept;
+
+ private:
+  /// The underlying postgres connection. We have this in here to prevent its
+  /// destruction for the lifetime of the iterator.
+  ConnPtr conn_;
+
+  /// The result that is currently being consumed.
+  ResultPtr current_;
+
+  /// Whether the end is reached.
+  bool end_;
+
+  /// Whether the results are fetched in the binary format.
+  bool binary_;
+
+  /// Whether the query was sent inside a transaction block, in which case it
+  /// must not be cancelled.
+  bool in_transaction_;
+
+  /// Whether the columns are expected to hold enums.
+  std::vector<bool> is_enum_;
+
+  /// The OIDs of the column types of the prepared statement.
+  std::vector<Oid> oids_;
+
+  /// Whether the final result has been received.
+  bool received_all_;
+
+  /// The index of the next row in current_.
+  int row_ix_;
+
+  /// Whether the query has been sent.
+  bool sent_;
+
+  /// The values bound to the parameters of the prepared statement.
+  std::vector<std::optional<std::string>> params_;
+
+  /// The query, if it has not been prepared.
+  std::string sql_;
+
+  /// The name of the prepared statement, empty for the unnamed statement.
+  std::string stmt_name_;
+};
+
+}  // namespace sqlgen::postgres
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SQLGEN_POSTGRES_BINARY_HPP_
+#define SQLGEN_POSTGRES_BINARY_HPP_
+
+#include <libpq-fe.h>
+
+#include <cstddef>
+#include <string>
+
+#include "../Result.hpp"
+#include "../RowBatch.hpp"
+
+namespace sqlgen::postgres::binary {
+
+/// Whether values of the type identified by _oid can be decoded from the
+/// binary result format.
+bool is_decodable(const Oid _oid) noexcept;
+
+/// Decodes a value in the binary result format and appends it to _batch.
+void push_back(const Oid _oid, const char* _ptr, const size_t _len,
+               RowBatch* _batch);
+
+/// Whether values can be encoded for columns of the type identified by _oid
+/// when using COPY in the binary format.
+bool is_encodable(const Oid _oid) noexcept;
+
+/// Encodes _cell as a value of the type identified by _oid, as expected by
+/// COPY in the binary format, and appends it to _buffer, prefixed by its
+/// length.
+Result<Nothing> append(const Oid _oid, const RowBatch::Cell& _cell,
+                       std::string* _buffer) noexcept;
+
+}  // namespace sqlgen::postgres::binary
+
+#endif
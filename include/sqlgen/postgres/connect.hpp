@@ -3,8 +3,10 @@
 
 #include <string>
 
+#include "AsyncConnection.hpp"
 #include "Connection.hpp"
 #include "Credentials.hpp"
+#include "EventLoop.hpp"
 
 namespace sqlgen::postgres {
 
@@ -12,6 +14,11 @@ inline auto connect(const Credentials& _credentials) {
   return Connection::make(_credentials);
 }
 
+/// Returns a task, which connects without blocking, when awaited.
+inline auto connect_async(EventLoop* _loop, const Credentials& _credentials) {
+  return AsyncConnection::connect(_loop, _credentials);
+}
+
 }  // namespace sqlgen::postgres
 
 #endif
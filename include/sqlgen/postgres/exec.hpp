@@ -3,16 +3,37 @@
 
 #include <libpq-fe.h>
 
+#include <optional>
 #include <rfl.hpp>
 #include <string>
+#include <vector>
 
 #include "../Ref.hpp"
 #include "../Result.hpp"
 
 namespace sqlgen::postgres {
 
-Result<Ref<PGresult>> exec(const Ref<PGconn>& _conn,
-                           const std::string& _sql) noexcept;
+/// Executes _sql. If _binary is true, the results are requested in the
+/// binary format, which only works for a single statement.
+Result<Ref<PGresult>> exec(const Ref<PGconn>& _conn, const std::string& _sql,
+                           const bool _binary = false) noexcept;
+
+/// Executes _sql, binding _params to its parameters, in the text format.
+/// NULL values are represented by std::nullopt.
+Result<Ref<PGresult>> exec(
+    const Ref<PGconn>& _conn, const std::string& _sql,
+    const std::vector<std::optional<std::string>>& _params) noexcept;
+
+/// Executes the statement prepared under _stmt_name, binding _params to its
+/// parameters, in the text format.
+Result<Ref<PGresult>> exec_prepared(
+    const Ref<PGconn>& _conn, const std::string& _stmt_name,
+    const std::vector<std::optional<std::string>>& _params) noexcept;
+
+/// Checks the status of _res and takes ownership of it. _sql is only used
+/// in the error message.
+Result<Ref<PGresult>> wrap_result(PGresult* _res,
+                                  const std::string& _sql) noexcept;
 
 }  // namespace sqlgen::postgres
 
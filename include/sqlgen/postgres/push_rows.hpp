@@ -0,0 +1,21 @@
+#ifndef SQLGEN_POSTGRES_PUSH_ROWS_HPP_
+#define SQLGEN_POSTGRES_PUSH_ROWS_HPP_
+
+#include <libpq-fe.h>
+
+#include <vector>
+
+#include "../RowBatch.hpp"
+
+namespace sqlgen::postgres {
+
+/// Appends the rows [_begin, _end) of _res to _batch. If _binary is true,
+/// the values are decoded from the binary format, using the column types
+/// in _oids.
+void push_rows(const PGresult* _res, const int _begin, const int _end,
+               const bool _binary, const std::vector<Oid>& _oids,
+               RowBatch* _batch);
+
+}  // namespace sqlgen::postgres
+
+#endif
@@ -4,6 +4,7 @@
 #include <string>
 #include <type_traits>
 
+#include "../dynamic/Arena.hpp"
 #include "../dynamic/Statement.hpp"
 #include "../transpilation/to_sql.hpp"
 
@@ -12,12 +13,20 @@ namespace sqlgen::postgres {
 /// Transpiles a dynamic general SQL statement to the postgres dialect.
 std::string to_sql_impl(const dynamic::Statement& _stmt) noexcept;
 
+/// Transpiles _stmt to a COPY statement expecting the binary format.
+std::string write_binary_to_sql(const dynamic::Write& _stmt) noexcept;
+
+/// Transpiles _stmt to a query that returns no rows, but the types of the
+/// columns written to.
+std::string write_types_to_sql(const dynamic::Write& _stmt) noexcept;
+
 /// Transpiles any  SQL statement to the postgres dialect.
 template <class T>
 std::string to_sql(const T& _t) noexcept {
   if constexpr (std::is_same_v<std::remove_cvref_t<T>, dynamic::Statement>) {
     return to_sql_impl(_t);
   } else {
+    dynamic::Arena arena;
     return to_sql_impl(transpilation::to_sql(_t));
   }
 }
@@ -0,0 +1,20 @@
+#ifndef SQLGEN_PREFETCH_HPP_
+#define SQLGEN_PREFETCH_HPP_
+
+#include <cstddef>
+
+namespace sqlgen {
+
+/// The number of batches to fetch and decode in the background.
+struct Prefetch {
+  size_t depth;
+};
+
+/// Fetches and decodes up to _depth batches on a worker thread while the
+/// current batch is being consumed. The connection must not be used for
+/// anything else while the result is being read.
+inline auto prefetch(const size_t _depth = 1) { return Prefetch{_depth}; }
+
+}  // namespace sqlgen
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef SQLGEN_PREPARE_HPP_
+#define SQLGEN_PREPARE_HPP_
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <ranges>
+#include <rfl.hpp>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include "Ref.hpp"
+#include "Result.hpp"
+#include "RowBatch.hpp"
+#include "dynamic/Statement.hpp"
+#include "internal/number_params.hpp"
+#include "is_connection.hpp"
+#include "parsing/write_to.hpp"
+#include "read.hpp"
+#include "transpilation/read_to_select_from.hpp"
+#include "transpilation/to_sql.hpp"
+#include "transpilation/value_t.hpp"
+
+namespace sqlgen {
+namespace internal {
+
+template <class QueryType>
+struct IsRead : std::false_type {};
+
+template <class T, class WhereType, class OrderByType, class LimitType>
+struct IsRead<Read<T, WhereType, OrderByType, LimitType>> : std::true_type {
+  using ContainerType = T;
+
+  /// Used when T is not a container, but a single object.
+  struct Single {
+    using Type = T;
+  };
+
+  using ValueType =
+      typename std::conditional_t<std::ranges::input_range<ContainerType>,
+                                  transpilation::ValueType<ContainerType>,
+                                  Single>::Type;
+
+  static dynamic::Statement to_statement(const auto& _read) {
+    return transpilation::read_to_select_from<ValueType, WhereType,
+                                              OrderByType, LimitType>(
+        _read.where_, _read.limit_);
+  }
+};
+
+}  // namespace internal
+
+/// A query that has been transpiled once, with placeholders in place of
+/// the values passed to param<...>(). The values are taken from the fields
+/// of ParamsType and bound every time the query is executed. The SQL is
+/// generated once for every type of connection the query is executed on.
+template <class ParamsType, class QueryType>
+class Prepared {
+ public:
+  Prepared(const QueryType& _query)
+      : query_(_query),
+        stmt_(to_statement(_query)),
+        names_(internal::number_params(&stmt_)),
+        sqls_(Ref<SQLs>::make()) {}
+
+  template <class Connection>
+    requires is_connection<Connection>
+  auto operator()(const Ref<Connection>& _conn,
+                  const ParamsType& _params) const {
+    if constexpr (internal::IsRead<QueryType>::value) {
+      using ContainerType =
+          typename internal::IsRead<QueryType>::ContainerType;
+      using ValueType = typename internal::IsRead<QueryType>::ValueType;
+      return to_row_batch(_params)
+          .and_then([&](const auto& _p) {
+            return _conn->read(sql(_conn), _p);
+          })
+          .and_then([&](const auto& _it) -> Result<ContainerType> {
+            if constexpr (std::ranges::input_range<ContainerType>) {
+              return to_container<ContainerType>(_it, query_.batch_size_,
+                                                 query_.prefetch_);
+            } else {
+              return to_container<std::vector<ValueType>>(
+                         _it, query_.batch_size_, query_.prefetch_)
+                  .and_then([](auto&& _vec) {
+                    return extract_single_result<ContainerType>(_vec);
+                  });
+            }
+          });
+    } else {
+      return to_row_batch(_params)
+          .and_then([&](const auto& _p) {
+            return _conn->execute(sql(_conn), _p);
+          })
+          .transform([&](const auto&) { return _conn; });
+    }
+  }
+
+  template <class Connection>
+    requires is_connection<Connection>
+  auto operator()(const Result<Ref<Connection>>& _res,
+                  const ParamsType& _params) const {
+    return _res.and_then(
+        [&](const auto& _conn) { return (*this)(_conn, _params); });
+  }
+
+  /// The names of the parameters, ordered by their position in the query.
+  const std::vector<std::string>& names() const noexcept { return names_; }
+
+  /// The transpiled query, which can be passed to the to_sql(...) function
+  /// of any dialect.
+  const dynamic::Statement& statement() const noexcept { return stmt_; }
+
+ private:
+  /// The SQL generated for every type of connection, which is shared
+  /// between all copies of the query.
+  struct SQLs {
+    std::shared_mutex mtx;
+
+    /// A deque, so that references remain valid when elements are added.
+    std::deque<std::pair<std::type_index, std::string>> sqls;
+  };
+
+  /// Returns the SQL for the dialect of _conn, generating it on first use.
+  template <class Connection>
+  const std::string& sql(const Ref<Connection>& _conn) const {
+    const auto type = std::type_index(typeid(Connection));
+    const auto find = [&]() -> const std::string* {
+      for (const auto& [t, sql] : sqls_->sqls) {
+        if (t == type) {
+          return &sql;
+        }
+      }
+      return nullptr;
+    };
+    {
+      std::shared_lock lock(sqls_->mtx);
+      if (const auto ptr = find()) {
+        return *ptr;
+      }
+    }
+    std::unique_lock lock(sqls_->mtx);
+    if (const auto ptr = find()) {
+      return *ptr;
+    }
+    sqls_->sqls.emplace_back(type, _conn->to_sql(stmt_));
+    return sqls_->sqls.back().second;
+  }
+
+  /// Writes the fields of _params into a single row, with one column for
+  /// every parameter, in the order of their positions.
+  Result<RowBatch> to_row_batch(const ParamsType& _params) const {
+    RowBatch fields(rfl::fields<ParamsType>().size());
+    const auto view = rfl::to_view(_params);
+    rfl::apply(
+        [&](const auto... _ptrs) {
+          (parsing::write_to(*_ptrs, &fields), ...);
+        },
+        view.values());
+
+    const auto field_names = rfl::fields<ParamsType>();
+
+    RowBatch params(names_.size());
+    for (const auto& name : names_) {
+      const auto it = std::find_if(
+          field_names.begin(), field_names.end(),
+          [&](const auto& _field) { return _field.name() == name; });
+      if (it == field_names.end()) {
+        return error("The parameters have no field called '" + name + "'.");
+      }
+      params.push_cell(fields[0][static_cast<size_t>(
+          std::distance(field_names.begin(), it))]);
+    }
+    return params;
+  }
+
+  static dynamic::Statement to_statement(const QueryType& _query) {
+    if constexpr (internal::IsRead<QueryType>::value) {
+      return internal::IsRead<QueryType>::to_statement(_query);
+    } else {
+      return transpilation::to_sql(_query);
+    }
+  }
+
+ private:
+  /// The original query.
+  QueryType query_;
+
+  /// The transpiled query, with the positions of the parameters assigned.
+  dynamic::Statement stmt_;
+
+  /// The names of the parameters, ordered by their position.
+  std::vector<std::string> names_;
+
+  /// The SQL generated for every type of connection.
+  Ref<SQLs> sqls_;
+};
+
+/// Transpiles _query once, so that it can be executed many times, binding
+/// the fields of ParamsType to the parameters declared with param<...>().
+template <class ParamsType, class QueryType>
+auto prepare(const QueryType& _query) {
+  return Prepared<ParamsType, QueryType>(_query);
+}
+
+}  // namespace sqlgen
+
+#endif
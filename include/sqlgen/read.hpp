@@ -2,15 +2,24 @@
 #define SQLGEN_READ_HPP_
 
 #include <ranges>
+#include <string>
 #include <type_traits>
+#include <vector>
 
+#include "IteratorBase.hpp"
 #include "Range.hpp"
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "RowBatch.hpp"
+#include "Task.hpp"
+#include "batch_size.hpp"
+#include "dynamic/Arena.hpp"
 #include "internal/is_range.hpp"
+#include "is_async_connection.hpp"
 #include "is_connection.hpp"
 #include "limit.hpp"
 #include "order_by.hpp"
+#include "prefetch.hpp"
 #include "transpilation/order_by_t.hpp"
 #include "transpilation/read_to_select_from.hpp"
 #include "transpilation/value_t.hpp"
@@ -18,36 +27,98 @@
 
 namespace sqlgen {
 
+/// Reads the rows returned by _it into a container.
+template <class ContainerType>
+Result<ContainerType> to_container(const Ref<IteratorBase>& _it,
+                                   const BatchSize& _batch_size,
+                                   const size_t _prefetch) {
+  using ValueType = transpilation::value_t<ContainerType>;
+  if constexpr (internal::is_range_v<ContainerType>) {
+    return ContainerType(_it, _batch_size, _prefetch);
+
+  } else {
+    ContainerType container;
+    for (auto& res : Range<ValueType>(_it, _batch_size, _prefetch)) {
+      if (res) {
+        container.emplace_back(std::move(*res));
+      } else {
+        return error(res.error().what());
+      }
+    }
+    return container;
+  }
+}
+
+/// Used when the provided type is not a container.
+template <class Type, class VecType>
+Result<Type> extract_single_result(VecType&& _vec) {
+  if (_vec.size() != 1) {
+    return error(
+        "Because the provided type was not a container, the query "
+        "needs to return exactly one result, but it did return " +
+        std::to_string(_vec.size()) + " results.");
+  }
+  return std::move(_vec[0]);
+}
+
 template <class ContainerType, class WhereType, class OrderByType,
           class LimitType, class Connection>
   requires is_connection<Connection>
 Result<ContainerType> read_impl(const Ref<Connection>& _conn,
                                 const WhereType& _where,
-                                const LimitType& _limit) {
+                                const LimitType& _limit,
+                                const BatchSize& _batch_size,
+                                const size_t _prefetch) {
   using ValueType = transpilation::value_t<ContainerType>;
-  if constexpr (internal::is_range_v<ContainerType>) {
-    const auto query =
+
+  const auto to_result = [&](const auto& _it) {
+    return to_container<ContainerType>(_it, _batch_size, _prefetch);
+  };
+
+  if constexpr (std::is_same_v<WhereType, Nothing> &&
+                std::is_same_v<LimitType, Nothing>) {
+    // Without a WHERE or LIMIT clause, the query is fully determined by
+    // the types, so the SQL only needs to be generated once.
+    static const auto sql = _conn->to_sql(
         transpilation::read_to_select_from<ValueType, WhereType, OrderByType,
-                                           LimitType>(_where, _limit);
-    return _conn->read(query).transform(
-        [](auto&& _it) { return ContainerType(_it); });
+                                           LimitType>(_where, _limit));
+    return _conn->read(sql, RowBatch()).and_then(to_result);
 
   } else {
-    const auto to_container = [](auto range) -> Result<ContainerType> {
-      ContainerType container;
-      for (auto& res : range) {
-        if (res) {
-          container.emplace_back(std::move(*res));
-        } else {
-          return error(res.error().what());
-        }
-      }
-      return container;
-    };
+    // The tree only lives until the SQL has been generated, so all of its
+    // nodes can be allocated in an arena and released at once, before the
+    // query is sent.
+    const auto sql = [&]() {
+      dynamic::Arena arena;
+      return _conn->to_sql(
+          transpilation::read_to_select_from<ValueType, WhereType,
+                                             OrderByType, LimitType>(_where,
+                                                                     _limit));
+    }();
+    return _conn->read(sql, RowBatch()).and_then(to_result);
+  }
+}
 
-    return read_impl<Range<ValueType>, WhereType, OrderByType, LimitType>(
-               _conn, _where, _limit)
-        .and_then(to_container);
+/// Reads the results of _sql asynchronously into Type, which is either a
+/// container or a single object.
+template <class Type, class Connection>
+  requires is_async_connection<Connection>
+Task<Result<Type>> read_async(const Ref<Connection> _conn,
+                              const std::string _sql,
+                              const BatchSize _batch_size,
+                              const size_t _prefetch) {
+  const auto it = co_await _conn->read(_sql, RowBatch());
+  if constexpr (std::ranges::input_range<std::remove_cvref_t<Type>>) {
+    co_return it.and_then([&](const auto& _it) {
+      return to_container<Type>(_it, _batch_size, _prefetch);
+    });
+  } else {
+    co_return it
+        .and_then([&](const auto& _it) {
+          return to_container<std::vector<Type>>(_it, _batch_size, _prefetch);
+        })
+        .and_then(
+            [](auto&& _vec) { return extract_single_result<Type>(_vec); });
   }
 }
 
@@ -56,10 +127,12 @@ template <class ContainerType, class WhereType, class OrderByType,
   requires is_connection<Connection>
 Result<ContainerType> read_impl(const Result<Ref<Connection>>& _res,
                                 const WhereType& _where,
-                                const LimitType& _limit) {
+                                const LimitType& _limit,
+                                const BatchSize& _batch_size,
+                                const size_t _prefetch) {
   return _res.and_then([&](const auto& _conn) {
     return read_impl<ContainerType, WhereType, OrderByType, LimitType>(
-        _conn, _where, _limit);
+        _conn, _where, _limit, _batch_size, _prefetch);
   });
 }
 
@@ -68,23 +141,46 @@ template <class Type, class WhereType = Nothing, class OrderByType = Nothing,
 struct Read {
   Result<Type> operator()(const auto& _conn) const {
     if constexpr (std::ranges::input_range<std::remove_cvref_t<Type>>) {
-      return read_impl<Type, WhereType, OrderByType, LimitType>(_conn, where_,
-                                                                limit_);
+      return read_impl<Type, WhereType, OrderByType, LimitType>(
+          _conn, where_, limit_, batch_size_, prefetch_);
 
     } else {
-      const auto extract_result = [](auto&& _vec) -> Result<Type> {
-        if (_vec.size() != 1) {
-          return error(
-              "Because the provided type was not a container, the query "
-              "needs to return exactly one result, but it did return " +
-              std::to_string(_vec.size()) + " results.");
-        }
-        return std::move(_vec[0]);
-      };
-
       return read_impl<std::vector<Type>, WhereType, OrderByType, LimitType>(
-                 _conn, where_, limit_)
-          .and_then(extract_result);
+                 _conn, where_, limit_, batch_size_, prefetch_)
+          .and_then([](auto&& _vec) {
+            return extract_single_result<Type>(_vec);
+          });
+    }
+  }
+
+  /// Returns a task, which reads the results without blocking, when awaited.
+  template <class Connection>
+    requires is_async_connection<Connection>
+  Task<Result<Type>> operator()(const Ref<Connection>& _conn) const {
+    using ContainerType =
+        std::conditional_t<std::ranges::input_range<std::remove_cvref_t<Type>>,
+                           Type, std::vector<Type>>;
+    using ValueType = transpilation::value_t<ContainerType>;
+
+    // The SQL is generated right away, so the task does not depend on the
+    // lifetime of the query.
+    if constexpr (std::is_same_v<WhereType, Nothing> &&
+                  std::is_same_v<LimitType, Nothing>) {
+      static const auto sql = _conn->to_sql(
+          transpilation::read_to_select_from<ValueType, WhereType,
+                                             OrderByType, LimitType>(where_,
+                                                                     limit_));
+      return read_async<Type>(_conn, sql, batch_size_, prefetch_);
+
+    } else {
+      const auto sql = [&]() {
+        dynamic::Arena arena;
+        return _conn->to_sql(
+            transpilation::read_to_select_from<ValueType, WhereType,
+                                               OrderByType, LimitType>(
+                where_, limit_));
+      }();
+      return read_async<Type>(_conn, sql, batch_size_, prefetch_);
     }
   }
 
@@ -98,7 +194,9 @@ struct Read {
     static_assert(std::is_same_v<LimitType, Nothing>,
                   "You cannot call limit(...) before where(...).");
     return Read<Type, ConditionType, OrderByType, LimitType>{
-        .where_ = _where.condition};
+        .where_ = _where.condition,
+        .batch_size_ = _r.batch_size_,
+        .prefetch_ = _r.prefetch_};
   }
 
   template <class... ColTypes>
@@ -115,19 +213,42 @@ struct Read {
                 transpilation::order_by_t<
                     transpilation::value_t<Type>, Nothing,
                     typename std::remove_cvref_t<ColTypes>::ColType...>,
-                LimitType>{.where_ = _r.where_};
+                LimitType>{.where_ = _r.where_,
+                           .batch_size_ = _r.batch_size_,
+                           .prefetch_ = _r.prefetch_};
   }
 
   friend auto operator|(const Read& _r, const Limit& _limit) {
     static_assert(std::is_same_v<LimitType, Nothing>,
                   "You cannot call limit(...) twice.");
-    return Read<Type, WhereType, OrderByType, Limit>{.where_ = _r.where_,
-                                                     .limit_ = _limit};
+    return Read<Type, WhereType, OrderByType, Limit>{
+        .where_ = _r.where_,
+        .limit_ = _limit,
+        .batch_size_ = _r.batch_size_,
+        .prefetch_ = _r.prefetch_};
+  }
+
+  friend auto operator|(const Read& _r, const BatchSize& _batch_size) {
+    auto r = _r;
+    r.batch_size_ = _batch_size;
+    return r;
+  }
+
+  friend auto operator|(const Read& _r, const Prefetch& _prefetch) {
+    auto r = _r;
+    r.prefetch_ = _prefetch.depth;
+    return r;
   }
 
   WhereType where_;
 
   LimitType limit_;
+
+  /// Determines how many rows are fetched at once.
+  BatchSize batch_size_;
+
+  /// The number of batches to fetch in the background, 0 if disabled.
+  size_t prefetch_ = 0;
 };
 
 template <class ContainerType>
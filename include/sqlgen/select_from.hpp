@@ -8,7 +8,9 @@
 #include "Range.hpp"
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "RowBatch.hpp"
 #include "col.hpp"
+#include "dynamic/Arena.hpp"
 #include "dynamic/Join.hpp"
 #include "dynamic/SelectFrom.hpp"
 #include "group_by.hpp"
@@ -41,12 +43,16 @@ auto select_from_impl(const Ref<Connection>& _conn, const FieldsType& _fields,
                       const JoinsType& _joins, const WhereType& _where,
                       const LimitType& _limit) {
   if constexpr (internal::is_range_v<ContainerType>) {
-    const auto query =
-        transpilation::to_select_from<TableTupleType, AliasType, FieldsType,
-                                      TableOrQueryType, JoinsType, WhereType,
-                                      GroupByType, OrderByType, LimitType>(
-            _fields, _table_or_query, _joins, _where, _limit);
-    return _conn->read(query).transform(
+    // The arena is released before the query is sent.
+    const auto sql = [&]() {
+      dynamic::Arena arena;
+      return _conn->to_sql(
+          transpilation::to_select_from<TableTupleType, AliasType, FieldsType,
+                                        TableOrQueryType, JoinsType, WhereType,
+                                        GroupByType, OrderByType, LimitType>(
+              _fields, _table_or_query, _joins, _where, _limit));
+    }();
+    return _conn->read(sql, RowBatch()).transform(
         [](auto&& _it) { return ContainerType(_it); });
 
   } else {
@@ -304,7 +310,7 @@ struct ToTableOrQuery<
   dynamic::SelectFrom::TableOrQueryType operator()(const auto& _query) {
     using TableTupleType =
         table_tuple_t<TableOrQueryType, AliasType, JoinsType>;
-    return Ref<dynamic::SelectFrom>::make(
+    return dynamic::NodeRef<dynamic::SelectFrom>::make(
         transpilation::to_select_from<TableTupleType, AliasType, FieldsType,
                                       TableOrQueryType, JoinsType, WhereType,
                                       GroupByType, OrderByType, LimitType>(
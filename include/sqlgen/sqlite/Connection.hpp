@@ -12,8 +12,12 @@
 #include "../IteratorBase.hpp"
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../StatementCacheStats.hpp"
 #include "../Transaction.hpp"
+#include "../dynamic/Statement.hpp"
 #include "../dynamic/Write.hpp"
+#include "../internal/StatementCache.hpp"
 #include "../is_connection.hpp"
 #include "to_sql.hpp"
 
@@ -24,10 +28,15 @@ class Connection {
   using StmtPtr = std::shared_ptr<sqlite3_stmt>;
 
  public:
-  Connection(const std::string& _fname)
-      : stmt_(nullptr), conn_(make_conn(_fname)) {}
+  Connection(const std::string& _fname,
+             const size_t _statement_cache_size = 100)
+      : stmt_(nullptr),
+        conn_(make_conn(_fname)),
+        stmt_cache_(_statement_cache_size) {}
 
-  static rfl::Result<Ref<Connection>> make(const std::string& _fname) noexcept;
+  static rfl::Result<Ref<Connection>> make(
+      const std::string& _fname,
+      const size_t _statement_cache_size = 100) noexcept;
 
   ~Connection() = default;
 
@@ -37,13 +46,21 @@ class Connection {
 
   Result<Nothing> execute(const std::string& _sql) noexcept;
 
-  Result<Nothing> insert(
-      const dynamic::Insert& _stmt,
-      const std::vector<std::vector<std::optional<std::string>>>&
-          _data) noexcept;
+  /// Executes _sql, binding the values in the first row of _params to its
+  /// parameters.
+  Result<Nothing> execute(const std::string& _sql,
+                          const RowBatch& _params) noexcept;
+
+  Result<Nothing> insert(const dynamic::Insert& _stmt,
+                         const RowBatch& _data) noexcept;
 
   Result<Ref<IteratorBase>> read(const dynamic::SelectFrom& _query);
 
+  /// Reads the results of the SELECT statement _sql, binding the values in
+  /// the first row of _params to its parameters.
+  Result<Ref<IteratorBase>> read(const std::string& _sql,
+                                 const RowBatch& _params);
+
   Result<Nothing> rollback() noexcept;
 
   std::string to_sql(const dynamic::Statement& _stmt) noexcept {
@@ -52,10 +69,14 @@ class Connection {
 
   Result<Nothing> start_write(const dynamic::Write& _stmt);
 
+  /// The number of hits and misses of the prepared statement cache.
+  StatementCacheStats statement_cache_stats() const noexcept {
+    return stmt_cache_.stats();
+  }
+
   Result<Nothing> end_write();
 
-  Result<Nothing> write(
-      const std::vector<std::vector<std::optional<std::string>>>& _data);
+  Result<Nothing> write(const RowBatch& _data);
 
  private:
   /// Generates the underlying connection.
@@ -63,20 +84,38 @@ class Connection {
 
   /// Actually inserts data based on a prepared statement -
   /// used by both .insert(...) and .write(...).
-  Result<Nothing> actual_insert(
-      const std::vector<std::vector<std::optional<std::string>>>& _data,
-      sqlite3_stmt* _stmt) const noexcept;
+  Result<Nothing> actual_insert(const RowBatch& _data,
+                                sqlite3_stmt* _stmt) const noexcept;
+
+  /// Binds the values in the first row of _params to the parameters of
+  /// _stmt. Does nothing, if _params is empty.
+  Result<Nothing> bind_params(const RowBatch& _params,
+                              sqlite3_stmt* _stmt) const noexcept;
+
+  /// Binds the values in _row to the parameters of _stmt. Text values are
+  /// bound using _text_destructor.
+  Result<Nothing> bind_row(
+      const RowBatch::Row& _row, sqlite3_stmt* _stmt,
+      const sqlite3_destructor_type _text_destructor) const noexcept;
+
+  /// Returns the prepared statement for _sql from the cache, preparing it
+  /// if necessary.
+  Result<StmtPtr> get_statement(const std::string& _sql) noexcept;
 
   /// Generates a prepared statment, usually for inserts.
   Result<StmtPtr> prepare_statement(const std::string& _sql) const noexcept;
 
  private:
-  /// A prepared statement - needed for the read and write operations. Note that
-  /// we have declared it before conn_, meaning it will be destroyed first.
+  /// The prepared statement used by the ongoing write operation.
   StmtPtr stmt_;
 
   /// The underlying sqlite3 connection.
   ConnPtr conn_;
+
+  /// Keeps the most recently used prepared statements. Declared after
+  /// conn_, so that the statements are finalized before the connection is
+  /// closed.
+  internal::StatementCache<StmtPtr> stmt_cache_;
 };
 
 static_assert(is_connection<Connection>,
@@ -10,6 +10,8 @@
 #include "../IteratorBase.hpp"
 #include "../Ref.hpp"
 #include "../Result.hpp"
+#include "../RowBatch.hpp"
+#include "../dynamic/Type.hpp"
 #include "Connection.hpp"
 
 namespace sqlgen::sqlite {
@@ -29,8 +31,11 @@ class Iterator : public sqlgen::IteratorBase {
   /// Returns the next batch of rows.
   /// If _batch_size is greater than the number of rows left, returns all
   /// of the rows left.
-  Result<std::vector<std::vector<std::optional<std::string>>>> next(
-      const size_t _batch_size) final;
+  Result<RowBatch> next(const size_t _batch_size) final;
+
+  /// Integer, boolean and floating point columns are extracted natively
+  /// using sqlite3_column_int64(...) and sqlite3_column_double(...).
+  void set_column_types(const std::vector<dynamic::Type>& _types) final;
 
  private:
   void step() { end_ = (sqlite3_step(stmt_.get()) != SQLITE_ROW); }
@@ -45,6 +50,9 @@ class Iterator : public sqlgen::IteratorBase {
   /// The number of columns.
   int num_cols_;
 
+  /// Whether the values in a column may be extracted natively.
+  std::vector<bool> is_native_;
+
   /// The prepared statement. Note that we have
   /// declared it before conn_, meaning it will be destroyed first.
   StmtPtr stmt_;
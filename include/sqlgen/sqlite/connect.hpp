@@ -1,14 +1,18 @@
 #ifndef SQLGEN_SQLITE_CONNECT_HPP_
 #define SQLGEN_SQLITE_CONNECT_HPP_
 
+#include <cstddef>
 #include <string>
 
 #include "Connection.hpp"
 
 namespace sqlgen::sqlite {
 
-inline auto connect(const std::string& _fname = ":memory:") {
-  return Connection::make(_fname);
+/// _statement_cache_size is the number of prepared statements kept per
+/// connection. Set it to 0 to disable the cache.
+inline auto connect(const std::string& _fname = ":memory:",
+                    const size_t _statement_cache_size = 100) {
+  return Connection::make(_fname, _statement_cache_size);
 }
 
 }  // namespace sqlgen::sqlite
@@ -3,6 +3,7 @@
 
 #include <string>
 
+#include "../dynamic/Arena.hpp"
 #include "../dynamic/Statement.hpp"
 #include "../transpilation/to_sql.hpp"
 
@@ -17,6 +18,7 @@ std::string to_sql(const T& _t) noexcept {
   if constexpr (std::is_same_v<std::remove_cvref_t<T>, dynamic::Statement>) {
     return to_sql_impl(_t);
   } else {
+    dynamic::Arena arena;
     return to_sql_impl(transpilation::to_sql(_t));
   }
 }
@@ -0,0 +1,21 @@
+#ifndef SQLGEN_TRANSPILATION_PARAM_HPP_
+#define SQLGEN_TRANSPILATION_PARAM_HPP_
+
+#include <rfl.hpp>
+#include <string>
+
+namespace sqlgen::transpilation {
+
+/// A placeholder for a value that is bound when a prepared query is
+/// executed.
+template <rfl::internal::StringLiteral _name>
+struct Param {
+  using Name = rfl::Literal<_name>;
+
+  /// Returns the name of the parameter.
+  std::string name() const noexcept { return Name().str(); }
+};
+
+}  // namespace sqlgen::transpilation
+
+#endif
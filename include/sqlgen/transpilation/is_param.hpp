@@ -0,0 +1,25 @@
+#ifndef SQLGEN_TRANSPILATION_IS_PARAM_HPP_
+#define SQLGEN_TRANSPILATION_IS_PARAM_HPP_
+
+#include <rfl.hpp>
+#include <type_traits>
+
+#include "Param.hpp"
+
+namespace sqlgen::transpilation {
+
+template <class T>
+class is_param;
+
+template <class T>
+class is_param : public std::false_type {};
+
+template <rfl::internal::StringLiteral _name>
+class is_param<Param<_name>> : public std::true_type {};
+
+template <class T>
+constexpr bool is_param_v = is_param<std::remove_cvref_t<T>>::value;
+
+}  // namespace sqlgen::transpilation
+
+#endif
@@ -16,6 +16,7 @@
 #include "Operation.hpp"
 #include "Operator.hpp"
 #include "OperatorCategory.hpp"
+#include "Param.hpp"
 #include "Value.hpp"
 #include "all_columns_exist.hpp"
 #include "dynamic_aggregation_t.hpp"
@@ -87,6 +88,21 @@ struct MakeField<TableTupleType, Value<T>> {
   }
 };
 
+template <class TableTupleType, rfl::internal::StringLiteral _name>
+struct MakeField<TableTupleType, Param<_name>> {
+  static constexpr bool is_aggregation = false;
+  static constexpr bool is_column = false;
+  static constexpr bool is_operation = false;
+
+  using Name = Nothing;
+  using Type = Param<_name>;
+
+  dynamic::SelectFrom::Field operator()(const auto&) const {
+    return dynamic::SelectFrom::Field{dynamic::Operation{
+        .val = dynamic::Value{dynamic::Param{.name = _name.str()}}}};
+  }
+};
+
 template <class TableTupleType, class ValueType,
           rfl::internal::StringLiteral _new_name>
 struct MakeField<TableTupleType, As<ValueType, _new_name>> {
@@ -165,7 +181,7 @@ struct MakeField<TableTupleType, Aggregation<_agg, ValueType>> {
     using DynamicAggregationType = dynamic_aggregation_t<_agg>;
     return dynamic::SelectFrom::Field{dynamic::Operation{
         .val = dynamic::Aggregation{DynamicAggregationType{
-            .val = Ref<dynamic::Operation>::make(
+            .val = dynamic::NodeRef<dynamic::Operation>::make(
                 MakeField<TableTupleType, std::remove_cvref_t<ValueType>>{}(
                     _val.val)
                     .val)}}}};
@@ -227,7 +243,7 @@ struct MakeField<TableTupleType, Operation<Operator::cast, Operand1Type,
   dynamic::SelectFrom::Field operator()(const auto& _o) const {
     return dynamic::SelectFrom::Field{
         dynamic::Operation{dynamic::Operation::Cast{
-            .op1 = Ref<dynamic::Operation>::make(
+            .op1 = dynamic::NodeRef<dynamic::Operation>::make(
                 MakeField<TableTupleType, std::remove_cvref_t<Operand1Type>>{}(
                     _o.operand1)
                     .val),
@@ -254,7 +270,7 @@ struct MakeField<TableTupleType,
   dynamic::SelectFrom::Field operator()(const auto& _o) const {
     return dynamic::SelectFrom::Field{
         dynamic::Operation{dynamic::Operation::DatePlusDuration{
-            .date = Ref<dynamic::Operation>::make(
+            .date = dynamic::NodeRef<dynamic::Operation>::make(
                 MakeField<TableTupleType, std::remove_cvref_t<Operand1Type>>{}(
                     _o.operand1)
                     .val),
@@ -280,7 +296,7 @@ struct MakeField<TableTupleType, Operation<_op, Operand1Type>> {
   dynamic::SelectFrom::Field operator()(const auto& _o) const {
     using DynamicOperatorType = dynamic_operator_t<_op>;
     return dynamic::SelectFrom::Field{dynamic::Operation{DynamicOperatorType{
-        .op1 = Ref<dynamic::Operation>::make(
+        .op1 = dynamic::NodeRef<dynamic::Operation>::make(
             MakeField<TableTupleType, std::remove_cvref_t<Operand1Type>>{}(
                 _o.operand1)
                 .val)}}};
@@ -303,11 +319,11 @@ struct MakeField<TableTupleType, Operation<_op, Operand1Type, Operand2Type>> {
   dynamic::SelectFrom::Field operator()(const auto& _o) const {
     using DynamicOperatorType = dynamic_operator_t<_op>;
     return dynamic::SelectFrom::Field{dynamic::Operation{DynamicOperatorType{
-        .op1 = Ref<dynamic::Operation>::make(
+        .op1 = dynamic::NodeRef<dynamic::Operation>::make(
             MakeField<TableTupleType, std::remove_cvref_t<Operand1Type>>{}(
                 _o.operand1)
                 .val),
-        .op2 = Ref<dynamic::Operation>::make(
+        .op2 = dynamic::NodeRef<dynamic::Operation>::make(
             MakeField<TableTupleType, std::remove_cvref_t<Operand2Type>>{}(
                 _o.operand2)
                 .val)}}};
@@ -332,15 +348,15 @@ struct MakeField<TableTupleType,
   dynamic::SelectFrom::Field operator()(const auto& _o) const {
     return dynamic::SelectFrom::Field{
         dynamic::Operation{dynamic::Operation::Replace{
-            .op1 = Ref<dynamic::Operation>::make(
+            .op1 = dynamic::NodeRef<dynamic::Operation>::make(
                 MakeField<TableTupleType, std::remove_cvref_t<Operand1Type>>{}(
                     _o.operand1)
                     .val),
-            .op2 = Ref<dynamic::Operation>::make(
+            .op2 = dynamic::NodeRef<dynamic::Operation>::make(
                 MakeField<TableTupleType, std::remove_cvref_t<Operand2Type>>{}(
                     _o.operand2)
                     .val),
-            .op3 = Ref<dynamic::Operation>::make(
+            .op3 = dynamic::NodeRef<dynamic::Operation>::make(
                 MakeField<TableTupleType, std::remove_cvref_t<Operand3Type>>{}(
                     _o.operand3)
                     .val)}}};
@@ -364,8 +380,8 @@ struct MakeField<TableTupleType, Operation<_op, rfl::Tuple<OperandTypes...>>> {
     return dynamic::SelectFrom::Field{dynamic::Operation{DynamicOperatorType{
         .ops = rfl::apply(
             [](const auto&... _ops) {
-              return std::vector<Ref<dynamic::Operation>>(
-                  {Ref<dynamic::Operation>::make(
+              return std::vector<dynamic::NodeRef<dynamic::Operation>>(
+                  {dynamic::NodeRef<dynamic::Operation>::make(
                       MakeField<TableTupleType,
                                 std::remove_cvref_t<OperandTypes>>{}(_ops)
                           .val)...});
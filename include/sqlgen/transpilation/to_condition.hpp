@@ -6,12 +6,13 @@
 #include <type_traits>
 #include <vector>
 
-#include "../Ref.hpp"
 #include "../Result.hpp"
 #include "../dynamic/Condition.hpp"
+#include "../dynamic/NodeRef.hpp"
 #include "Condition.hpp"
 #include "all_columns_exist.hpp"
 #include "conditions.hpp"
+#include "is_param.hpp"
 #include "is_timestamp.hpp"
 #include "make_field.hpp"
 #include "to_transpilation_type.hpp"
@@ -34,9 +35,9 @@ struct ToCondition<T, conditions::And<CondType1, CondType2>> {
   dynamic::Condition operator()(const auto& _cond) const {
     return dynamic::Condition{
         .val = dynamic::Condition::And{
-            .cond1 = Ref<dynamic::Condition>::make(
+            .cond1 = dynamic::NodeRef<dynamic::Condition>::make(
                 ToCondition<T, std::remove_cvref_t<CondType1>>{}(_cond.cond1)),
-            .cond2 = Ref<dynamic::Condition>::make(
+            .cond2 = dynamic::NodeRef<dynamic::Condition>::make(
                 ToCondition<T, std::remove_cvref_t<CondType2>>{}(_cond.cond2)),
         }};
   }
@@ -49,7 +50,8 @@ struct ToCondition<T, conditions::Equal<Op1Type, Op2Type>> {
 
   static_assert(std::equality_comparable_with<Underlying1, Underlying2> ||
                     (is_timestamp_v<Underlying1> &&
-                     is_timestamp_v<Underlying2>),
+                     is_timestamp_v<Underlying2>) ||
+                    is_param_v<Underlying1> || is_param_v<Underlying2>,
                 "Must be equality comparable.");
 
   dynamic::Condition operator()(const auto& _cond) const {
@@ -66,7 +68,8 @@ struct ToCondition<T, conditions::GreaterEqual<Op1Type, Op2Type>> {
 
   static_assert(std::totally_ordered_with<Underlying1, Underlying2> ||
                     (is_timestamp_v<Underlying1> &&
-                     is_timestamp_v<Underlying2>),
+                     is_timestamp_v<Underlying2>) ||
+                    is_param_v<Underlying1> || is_param_v<Underlying2>,
                 "Must be totally ordered.");
 
   dynamic::Condition operator()(const auto& _cond) const {
@@ -83,7 +86,8 @@ struct ToCondition<T, conditions::GreaterThan<Op1Type, Op2Type>> {
 
   static_assert(std::totally_ordered_with<Underlying1, Underlying2> ||
                     (is_timestamp_v<Underlying1> &&
-                     is_timestamp_v<Underlying2>),
+                     is_timestamp_v<Underlying2>) ||
+                    is_param_v<Underlying1> || is_param_v<Underlying2>,
                 "Must be totally ordered.");
 
   dynamic::Condition operator()(const auto& _cond) const {
@@ -100,7 +104,8 @@ struct ToCondition<T, conditions::LesserEqual<Op1Type, Op2Type>> {
 
   static_assert(std::totally_ordered_with<Underlying1, Underlying2> ||
                     (is_timestamp_v<Underlying1> &&
-                     is_timestamp_v<Underlying2>),
+                     is_timestamp_v<Underlying2>) ||
+                    is_param_v<Underlying1> || is_param_v<Underlying2>,
                 "Must be totally ordered.");
 
   dynamic::Condition operator()(const auto& _cond) const {
@@ -117,7 +122,8 @@ struct ToCondition<T, conditions::LesserThan<Op1Type, Op2Type>> {
 
   static_assert(std::totally_ordered_with<Underlying1, Underlying2> ||
                     (is_timestamp_v<Underlying1> &&
-                     is_timestamp_v<Underlying2>),
+                     is_timestamp_v<Underlying2>) ||
+                    is_param_v<Underlying1> || is_param_v<Underlying2>,
                 "Must be totally ordered.");
 
   dynamic::Condition operator()(const auto& _cond) const {
@@ -162,7 +168,7 @@ struct ToCondition<T, conditions::Not<CondType>> {
   dynamic::Condition operator()(const auto& _cond) const {
     return dynamic::Condition{
         .val = dynamic::Condition::Not{
-            .cond = Ref<dynamic::Condition>::make(
+            .cond = dynamic::NodeRef<dynamic::Condition>::make(
                 ToCondition<T, std::remove_cvref_t<CondType>>{}(_cond.cond))}};
   }
 };
@@ -174,7 +180,8 @@ struct ToCondition<T, conditions::NotEqual<Op1Type, Op2Type>> {
 
   static_assert(std::equality_comparable_with<Underlying1, Underlying2> ||
                     (is_timestamp_v<Underlying1> &&
-                     is_timestamp_v<Underlying2>),
+                     is_timestamp_v<Underlying2>) ||
+                    is_param_v<Underlying1> || is_param_v<Underlying2>,
                 "Must be equality comparable.");
 
   dynamic::Condition operator()(const auto& _cond) const {
@@ -203,9 +210,9 @@ struct ToCondition<T, conditions::Or<CondType1, CondType2>> {
   dynamic::Condition operator()(const auto& _cond) const {
     return dynamic::Condition{
         .val = dynamic::Condition::Or{
-            .cond1 = Ref<dynamic::Condition>::make(
+            .cond1 = dynamic::NodeRef<dynamic::Condition>::make(
                 ToCondition<T, std::remove_cvref_t<CondType1>>{}(_cond.cond1)),
-            .cond2 = Ref<dynamic::Condition>::make(
+            .cond2 = dynamic::NodeRef<dynamic::Condition>::make(
                 ToCondition<T, std::remove_cvref_t<CondType2>>{}(_cond.cond2)),
         }};
   }
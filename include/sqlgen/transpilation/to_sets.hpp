@@ -11,6 +11,7 @@
 #include "../dynamic/Table.hpp"
 #include "../dynamic/Update.hpp"
 #include "Col.hpp"
+#include "Param.hpp"
 #include "Set.hpp"
 #include "all_columns_exist.hpp"
 #include "get_schema.hpp"
@@ -42,6 +43,21 @@ struct ToSet<T, Set<transpilation::Col<_name>, ToType>> {
   }
 };
 
+template <class T, rfl::internal::StringLiteral _name,
+          rfl::internal::StringLiteral _param_name>
+struct ToSet<T, Set<transpilation::Col<_name>, Param<_param_name>>> {
+  static_assert(
+      all_columns_exist<T, transpilation::Col<_name>>(),
+      "At least one column referenced in your SET query does not exist.");
+
+  dynamic::Update::Set operator()(const auto&) const {
+    return dynamic::Update::Set{
+        .col = dynamic::Column{.name = _name.str()},
+        .to = dynamic::Value{dynamic::Param{.name = _param_name.str()}},
+    };
+  }
+};
+
 template <class T, rfl::internal::StringLiteral _name1,
           rfl::internal::StringLiteral _name2>
 struct ToSet<T, Set<transpilation::Col<_name1>, transpilation::Col<_name2>>> {
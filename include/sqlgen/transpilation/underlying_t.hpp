@@ -10,6 +10,7 @@
 #include "Col.hpp"
 #include "Desc.hpp"
 #include "Operation.hpp"
+#include "Param.hpp"
 #include "Value.hpp"
 #include "all_columns_exist.hpp"
 #include "dynamic_operator_t.hpp"
@@ -280,6 +281,13 @@ struct Underlying<TableTupleType, Operation<_op, Operand1Type, Operand2Type>> {
                                   std::optional<ResultType>, ResultType>;
 };
 
+/// The type of a parameter is only known once it is bound, so conditions
+/// accept it in place of any value.
+template <class TableTupleType, rfl::internal::StringLiteral _name>
+struct Underlying<TableTupleType, Param<_name>> {
+  using Type = Param<_name>;
+};
+
 template <class TableTupleType, class _Type>
 struct Underlying<TableTupleType, Value<_Type>> {
   using Type = remove_reflection_t<_Type>;
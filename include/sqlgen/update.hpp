@@ -2,25 +2,36 @@
 #define SQLGEN_UPDATE_HPP_
 
 #include <rfl.hpp>
+#include <string>
 #include <type_traits>
 
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "Task.hpp"
+#include "dynamic/Arena.hpp"
+#include "is_async_connection.hpp"
 #include "is_connection.hpp"
 #include "transpilation/to_update.hpp"
 
 namespace sqlgen {
 
+/// Generates the UPDATE statement. The tree is allocated in an arena, which
+/// is released before the statement is executed.
+template <class ValueType, class SetsType, class WhereType, class Connection>
+std::string update_sql(const Ref<Connection>& _conn, const SetsType& _sets,
+                       const WhereType& _where) {
+  dynamic::Arena arena;
+  return _conn->to_sql(
+      transpilation::to_update<ValueType, SetsType, WhereType>(_sets, _where));
+}
+
 template <class ValueType, class SetsType, class WhereType, class Connection>
   requires is_connection<Connection>
 Result<Ref<Connection>> update_impl(const Ref<Connection>& _conn,
                                     const SetsType& _sets,
                                     const WhereType& _where) {
-  const auto query =
-      transpilation::to_update<ValueType, SetsType, WhereType>(_sets, _where);
-  return _conn->execute(_conn->to_sql(query)).transform([&](const auto&) {
-    return _conn;
-  });
+  return _conn->execute(update_sql<ValueType>(_conn, _sets, _where))
+      .transform([&](const auto&) { return _conn; });
 }
 
 template <class ValueType, class SetsType, class WhereType, class Connection>
@@ -33,6 +44,14 @@ Result<Ref<Connection>> update_impl(const Result<Ref<Connection>>& _res,
   });
 }
 
+template <class ValueType, class SetsType, class WhereType, class Connection>
+  requires is_async_connection<Connection>
+Task<Result<Ref<Connection>>> update_impl(const Ref<Connection>& _conn,
+                                          const SetsType& _sets,
+                                          const WhereType& _where) {
+  return execute_async(_conn, update_sql<ValueType>(_conn, _sets, _where));
+}
+
 template <class ValueType, class SetsType, class WhereType = Nothing>
 struct Update {
   auto operator()(const auto& _conn) const {
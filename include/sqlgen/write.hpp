@@ -12,9 +12,10 @@
 
 #include "Ref.hpp"
 #include "Result.hpp"
+#include "RowBatch.hpp"
 #include "dynamic/Write.hpp"
 #include "internal/batch_size.hpp"
-#include "internal/to_str_vec.hpp"
+#include "internal/write_row.hpp"
 #include "is_connection.hpp"
 #include "transpilation/to_create_table.hpp"
 #include "transpilation/to_insert_or_write.hpp"
@@ -28,17 +29,24 @@ Result<Ref<Connection>> write(const Ref<Connection>& _conn, ItBegin _begin,
   using T =
       std::remove_cvref_t<typename std::iterator_traits<ItBegin>::value_type>;
 
+  // The statements only depend on T and the dialect of the connection, so
+  // they are only generated once.
+  static const auto write_stmt =
+      transpilation::to_insert_or_write<T, dynamic::Write>();
+
+  static const auto create_table_sql =
+      _conn->to_sql(transpilation::to_create_table<T>());
+
   const auto start_write = [&](const auto&) -> Result<Nothing> {
-    const auto write_stmt =
-        transpilation::to_insert_or_write<T, dynamic::Write>();
     return _conn->start_write(write_stmt);
   };
 
   const auto write = [&](const auto&) -> Result<Nothing> {
-    std::vector<std::vector<std::optional<std::string>>> data;
+    RowBatch data(write_stmt.columns.size());
     for (auto it = _begin; it != _end; ++it) {
-      data.emplace_back(internal::to_str_vec(*it));
-      if (data.size() == SQLGEN_BATCH_SIZE) {
+      internal::write_row(*it, &data);
+      if (data.size() == SQLGEN_BATCH_SIZE ||
+          data.num_bytes() >= SQLGEN_BATCH_BYTES) {
         const auto res = _conn->write(data);
         if (!res) {
           _conn->end_write();
@@ -61,9 +69,7 @@ Result<Ref<Connection>> write(const Ref<Connection>& _conn, ItBegin _begin,
     return _conn->end_write();
   };
 
-  const auto create_table_stmt = transpilation::to_create_table<T>();
-
-  return _conn->execute(_conn->to_sql(create_table_stmt))
+  return _conn->execute(create_table_sql)
       .and_then(start_write)
       .and_then(write)
       .and_then(end_write)
@@ -1,5 +1,9 @@
 #include "sqlgen/mysql/Connection.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
 #include <cstring>
 #include <ranges>
 #include <rfl.hpp>
@@ -8,77 +12,169 @@
 #include <vector>
 
 #include "sqlgen/internal/collect/vector.hpp"
+#include "sqlgen/internal/native_to_text.hpp"
 #include "sqlgen/internal/strings/strings.hpp"
 #include "sqlgen/mysql/Iterator.hpp"
 #include "sqlgen/mysql/make_error.hpp"
 
 namespace sqlgen::mysql {
 
-Result<Nothing> Connection::actual_insert(
-    const std::vector<std::vector<std::optional<std::string>>>& _data,
-    MYSQL_STMT* _stmt) const noexcept {
+Result<Nothing> Connection::actual_insert(const RowBatch& _data,
+                                          const size_t _begin,
+                                          const size_t _end,
+                                          MYSQL_STMT* _stmt) const noexcept {
   const auto num_params = static_cast<size_t>(mysql_stmt_param_count(_stmt));
 
+  const auto num_cols = _data.num_cols();
+
+  if ((_end - _begin) * num_cols != num_params) {
+    return error("Expected " + std::to_string(num_params) + " fields, got " +
+                 std::to_string((_end - _begin) * num_cols) + ".");
+  }
+
   std::vector<MYSQL_BIND> bind(num_params);
 
   std::vector<long unsigned int> lengths(num_params);
   std::vector<my_bool> is_null(num_params);
 
-  for (const auto& row : _data) {
-    memset(bind.data(), 0, sizeof(MYSQL_BIND) * num_params);
+  // Native values are copied here, so that the binds never point into
+  // the batch for anything but text.
+  std::vector<long long> ints(num_params);
+  std::vector<double> doubles(num_params);
+  std::vector<std::array<char, 32>> bufs(num_params);
 
-    if (row.size() != num_params) {
-      return error("Expected " + std::to_string(num_params) + " fields, got " +
-                   std::to_string(row.size()) + ".");
-    }
+  memset(bind.data(), 0, sizeof(MYSQL_BIND) * num_params);
+
+  size_t k = 0;
+
+  for (size_t i = _begin; i < _end; ++i) {
+    const auto row = _data[i];
+
+    for (size_t j = 0; j < num_cols; ++j, ++k) {
+      const auto cell = row[j];
+
+      bind[k].is_null = &(is_null[k]);
+      is_null[k] = 0;
+
+      switch (cell.kind()) {
+        case RowBatch::Cell::Kind::null_value:
+          is_null[k] = 1;
+          bind[k].buffer_type = MYSQL_TYPE_NULL;
+          break;
+
+        case RowBatch::Cell::Kind::int64:
+          ints[k] = static_cast<long long>(cell.int64());
+          bind[k].buffer_type = MYSQL_TYPE_LONGLONG;
+          bind[k].buffer = &(ints[k]);
+          break;
 
-    auto buffer = row;
-
-    for (size_t i = 0; i < num_params; ++i) {
-      if (buffer[i]) {
-        lengths[i] = static_cast<long unsigned int>(row[i]->size());
-        is_null[i] = 0;
-
-        bind[i].buffer_type = MYSQL_TYPE_STRING;
-        bind[i].buffer = &((*buffer[i])[0]);
-        bind[i].buffer_length = lengths[i];
-        bind[i].is_null = &(is_null[i]);
-        bind[i].length = &(lengths[i]);
-      } else {
-        lengths[i] = 0;
-        is_null[i] = 1;
-
-        bind[i].buffer_type = MYSQL_TYPE_NULL;
-        bind[i].buffer = nullptr;
-        bind[i].buffer_length = 0;
-        bind[i].is_null = &(is_null[i]);
-        bind[i].length = 0;
+        case RowBatch::Cell::Kind::float64:
+          doubles[k] = cell.float64();
+          bind[k].buffer_type = MYSQL_TYPE_DOUBLE;
+          bind[k].buffer = &(doubles[k]);
+          break;
+
+        default: {
+          const auto str = internal::native_to_text(cell, &bufs[k]);
+          if (!str) {
+            return error(str.error().what());
+          }
+          lengths[k] = static_cast<long unsigned int>(str->size());
+          bind[k].buffer_type = MYSQL_TYPE_STRING;
+          bind[k].buffer = const_cast<char*>(str->data());
+          bind[k].buffer_length = lengths[k];
+          bind[k].length = &(lengths[k]);
+          break;
+        }
       }
     }
+  }
 
-    auto err = mysql_stmt_bind_param(_stmt, bind.data());
-    if (err) {
-      return make_error(conn_);
-    }
+  if (mysql_stmt_bind_param(_stmt, bind.data())) {
+    return make_error(conn_);
+  }
 
-    err = mysql_stmt_execute(_stmt);
-    if (err) {
-      return make_error(conn_);
-    }
+  if (mysql_stmt_execute(_stmt)) {
+    return make_error(conn_);
   }
 
   return Nothing{};
 }
 
-Result<Nothing> Connection::insert(
-    const dynamic::Insert& _stmt,
-    const std::vector<std::vector<std::optional<std::string>>>&
-        _data) noexcept {
+Result<Nothing> Connection::execute(const std::string& _sql,
+                                    const RowBatch& _params) noexcept {
+  return order_params(_sql, _params).and_then([&](const auto& _ordered) {
+    return stmt_cache_
+        .get(_sql,
+             [this](const std::string& _sql) {
+               return prepare_statement(_sql);
+             })
+        .and_then([&](const auto& _stmt_ptr) -> Result<Nothing> {
+          if (_ordered.num_cols() == 0) {
+            if (mysql_stmt_execute(_stmt_ptr.get())) {
+              return make_error(conn_);
+            }
+            return Nothing{};
+          }
+          return actual_insert(_ordered, 0, 1, _stmt_ptr.get());
+        });
+  });
+}
+
+Result<Nothing> Connection::insert(const dynamic::Insert& _stmt,
+                                   const RowBatch& _data) noexcept {
+  return insert_rows(_stmt, _data);
+}
+
+Result<Nothing> Connection::insert_rows(
+    const std::variant<dynamic::Insert, dynamic::Write>& _stmt,
+    const RowBatch& _data) noexcept {
   if (_data.size() == 0) {
     return Nothing{};
   }
-  return prepare_statement(_stmt).and_then(
-      [&](auto&& _stmt_ptr) { return actual_insert(_data, _stmt_ptr.get()); });
+
+  // Every statement inserts as many rows as the limits allow. If the number
+  // of rows is not a multiple of that, the remaining rows are inserted by a
+  // second, shorter statement.
+  const auto rows_per_stmt = rows_per_statement(_data);
+
+  const auto num_remaining = _data.size() % rows_per_stmt;
+
+  const auto with_num_rows = [&](const size_t _num_rows) {
+    return std::visit(
+        [&](auto _s) -> std::variant<dynamic::Insert, dynamic::Write> {
+          _s.num_rows = _num_rows;
+          return _s;
+        },
+        _stmt);
+  };
+
+  const auto insert_full = [&](auto&& _stmt_ptr) -> Result<Nothing> {
+    for (size_t begin = 0; begin + rows_per_stmt <= _data.size();
+         begin += rows_per_stmt) {
+      const auto res =
+          actual_insert(_data, begin, begin + rows_per_stmt, _stmt_ptr.get());
+      if (!res) {
+        return res;
+      }
+    }
+    return Nothing{};
+  };
+
+  const auto insert_remaining = [&](auto&&) -> Result<Nothing> {
+    if (num_remaining == 0) {
+      return Nothing{};
+    }
+    return get_statement(with_num_rows(num_remaining))
+        .and_then([&](auto&& _stmt_ptr) {
+          return actual_insert(_data, _data.size() - num_remaining,
+                               _data.size(), _stmt_ptr.get());
+        });
+  };
+
+  return get_statement(with_num_rows(rows_per_stmt))
+      .and_then(insert_full)
+      .and_then(insert_remaining);
 }
 
 rfl::Result<Ref<Connection>> Connection::make(
@@ -110,12 +206,66 @@ typename Connection::ConnPtr Connection::make_conn(
   return ConnPtr::make(shared_ptr).value();
 }
 
+Result<RowBatch> Connection::order_params(const std::string& _sql,
+                                          const RowBatch& _params) noexcept {
+  if (_params.size() == 0) {
+    return RowBatch();
+  }
+
+  const auto row = _params[0];
+
+  std::vector<size_t> order;
+
+  // Placeholders are rendered as ?/*N*/, so we need to skip string literals
+  // and quoted identifiers, which might contain the same characters.
+  char quote = '\0';
+  for (size_t i = 0; i < _sql.size(); ++i) {
+    const char c = _sql[i];
+    if (quote != '\0') {
+      if (c == '\\') {
+        ++i;
+      } else if (c == quote) {
+        quote = '\0';
+      }
+    } else if (c == '\'' || c == '"' || c == '`') {
+      quote = c;
+    } else if (_sql.compare(i, 3, "?/*") == 0) {
+      const auto end = _sql.find("*/", i + 3);
+      if (end == std::string::npos) {
+        break;
+      }
+      size_t ix = 0;
+      std::from_chars(_sql.data() + i + 3, _sql.data() + end, ix);
+      if (ix == 0 || ix > row.size()) {
+        return error("Parameter " + std::to_string(ix) +
+                     " is out of range, there are " +
+                     std::to_string(row.size()) + " parameters.");
+      }
+      order.push_back(ix - 1);
+      i = end + 1;
+    }
+  }
+
+  auto ordered = RowBatch(order.size());
+  for (const auto j : order) {
+    ordered.push_cell(row[j]);
+  }
+  return ordered;
+}
+
+Result<Connection::StmtPtr> Connection::get_statement(
+    const std::variant<dynamic::Insert, dynamic::Write>& _stmt) noexcept {
+  return stmt_cache_.get(std::visit(to_sql_impl, _stmt),
+                         [this](const std::string& _sql) {
+                           return prepare_statement(_sql);
+                         });
+}
+
 Result<Connection::StmtPtr> Connection::prepare_statement(
-    const std::variant<dynamic::Insert, dynamic::Write>& _stmt) const noexcept {
-  const auto sql = std::visit(to_sql_impl, _stmt);
+    const std::string& _sql) const noexcept {
   const auto stmt_ptr = StmtPtr(mysql_stmt_init(conn_.get()), mysql_stmt_close);
-  const auto err = mysql_stmt_prepare(stmt_ptr.get(), sql.c_str(),
-                                      static_cast<unsigned long>(sql.size()));
+  const auto err = mysql_stmt_prepare(stmt_ptr.get(), _sql.c_str(),
+                                      static_cast<unsigned long>(_sql.size()));
   if (err) {
     return make_error(conn_);
   }
@@ -123,55 +273,118 @@ Result<Connection::StmtPtr> Connection::prepare_statement(
 }
 
 Result<Ref<IteratorBase>> Connection::read(const dynamic::SelectFrom& _query) {
-  const auto sql = mysql::to_sql_impl(_query);
-  const auto err =
-      mysql_real_query(conn_.get(), sql.c_str(), static_cast<int>(sql.size()));
-  if (err) {
-    return make_error(conn_);
+  return read(mysql::to_sql_impl(_query), RowBatch());
+}
+
+Result<Ref<IteratorBase>> Connection::read(const std::string& _sql,
+                                          const RowBatch& _params) {
+  const auto ordered = order_params(_sql, _params);
+  if (!ordered) {
+    return error(ordered.error().what());
   }
-  const auto raw_ptr = mysql_use_result(conn_.get());
+
+  const auto raw_ptr = mysql_stmt_init(conn_.get());
   if (!raw_ptr) {
     return make_error(conn_);
   }
-  return Ref<MYSQL_RES>::make(
-             std::shared_ptr<MYSQL_RES>(raw_ptr, mysql_free_result))
-      .transform([&](auto&& _res) { return Ref<Iterator>::make(_res, conn_); });
+
+  const auto stmt_ptr =
+      Ref<MYSQL_STMT>::make(
+          std::shared_ptr<MYSQL_STMT>(raw_ptr, mysql_stmt_close))
+          .value();
+
+  const unsigned long cursor_type = CURSOR_TYPE_READ_ONLY;
+  if (mysql_stmt_attr_set(stmt_ptr.get(), STMT_ATTR_CURSOR_TYPE,
+                          &cursor_type)) {
+    return make_error(stmt_ptr.get());
+  }
+
+  if (mysql_stmt_attr_set(stmt_ptr.get(), STMT_ATTR_PREFETCH_ROWS,
+                          &prefetch_rows_)) {
+    return make_error(stmt_ptr.get());
+  }
+
+  if (mysql_stmt_prepare(stmt_ptr.get(), _sql.c_str(),
+                         static_cast<unsigned long>(_sql.size()))) {
+    return make_error(stmt_ptr.get());
+  }
+
+  if (ordered->num_cols() == 0) {
+    if (mysql_stmt_execute(stmt_ptr.get())) {
+      return make_error(stmt_ptr.get());
+    }
+  } else {
+    // Binds the parameters and executes the statement.
+    const auto res = actual_insert(*ordered, 0, 1, stmt_ptr.get());
+    if (!res) {
+      return error(res.error().what());
+    }
+  }
+
+  return Ref<IteratorBase>(Ref<Iterator>::make(stmt_ptr, conn_));
+}
+
+size_t Connection::rows_per_statement(const RowBatch& _data) noexcept {
+  const auto num_cols = std::max<size_t>(_data.num_cols(), 1);
+
+  // Apart from its value, every parameter takes up a few bytes for its type,
+  // its length and its bit in the NULL bitmap. Native values are sent in at
+  // most this many bytes as well.
+  constexpr size_t bytes_per_param = 32;
+
+  size_t max_row_bytes = num_cols * bytes_per_param;
+  for (size_t i = 0; i < _data.size(); ++i) {
+    const auto row = _data[i];
+    size_t row_bytes = num_cols * bytes_per_param;
+    for (size_t j = 0; j < _data.num_cols(); ++j) {
+      const auto cell = row[j];
+      if (!cell.is_native()) {
+        row_bytes += cell.text().size();
+      }
+    }
+    max_row_bytes = std::max(max_row_bytes, row_bytes);
+  }
+
+  const auto by_params = max_params_ / num_cols;
+
+  const auto by_bytes = std::max<size_t>(max_bytes_ / max_row_bytes, 1);
+
+  if (by_bytes < std::min(by_params, _data.size())) {
+    // Rounded down to a power of two, so that batches with similar row sizes
+    // share the same prepared statement.
+    return std::bit_floor(by_bytes);
+  }
+
+  return std::max<size_t>(std::min(by_params, _data.size()), 1);
 }
 
 Result<Nothing> Connection::start_write(const dynamic::Write& _write_stmt) {
-  if (stmt_) {
+  if (write_stmt_) {
     return error(
         "A write operation has already been launched. You need to call "
         ".end_write() before you can start another.");
   }
-  return begin_transaction()
-      .and_then([&](auto&&) { return prepare_statement(_write_stmt); })
-      .transform([&](auto&& _stmt) {
-        stmt_ = _stmt;
-        return Nothing{};
-      })
-      .or_else([&](auto&& _err) {
-        rollback();
-        return error(_err.what());
-      });
+  return begin_transaction().transform([&](auto&&) {
+    write_stmt_ = _write_stmt;
+    return Nothing{};
+  });
 }
 
-Result<Nothing> Connection::write(
-    const std::vector<std::vector<std::optional<std::string>>>& _data) {
-  if (!stmt_) {
+Result<Nothing> Connection::write(const RowBatch& _data) {
+  if (!write_stmt_) {
     return error(
         " You need to call .start_write(...) before you can call "
         ".write(...).");
   }
-  return actual_insert(_data, stmt_.get()).or_else([&](const auto& _err) {
+  return insert_rows(*write_stmt_, _data).or_else([&](const auto& _err) {
     rollback();
-    stmt_ = nullptr;
+    write_stmt_ = std::nullopt;
     return error(_err.what());
   });
 }
 
 Result<Nothing> Connection::end_write() {
-  stmt_ = nullptr;
+  write_stmt_ = std::nullopt;
   return commit();
 }
 
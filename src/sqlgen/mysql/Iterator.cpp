@@ -1,44 +1,230 @@
 #include "sqlgen/mysql/Iterator.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "sqlgen/mysql/make_error.hpp"
+
 namespace sqlgen::mysql {
 
-Iterator::Iterator(const ResPtr& _res, const ConnPtr& _conn)
-    : res_(_res), conn_(_conn), end_(false) {}
+Iterator::Iterator(const StmtPtr& _stmt, const ConnPtr& _conn)
+    : bound_(false), stmt_(_stmt), conn_(_conn), end_(false) {}
 
 Iterator::~Iterator() = default;
 
-Result<std::vector<std::vector<std::optional<std::string>>>> Iterator::next(
-    const size_t _batch_size) {
-  std::vector<std::vector<std::optional<std::string>>> vec;
+Result<Nothing> Iterator::bind() {
+  const auto meta = std::shared_ptr<MYSQL_RES>(
+      mysql_stmt_result_metadata(stmt_.get()), mysql_free_result);
+  if (!meta) {
+    return make_error(stmt_.get());
+  }
+
+  const auto num_fields = static_cast<size_t>(mysql_num_fields(meta.get()));
+
+  cols_ = std::vector<Column>(num_fields);
+  binds_ = std::vector<MYSQL_BIND>(num_fields);
+  std::memset(binds_.data(), 0, sizeof(MYSQL_BIND) * num_fields);
+
+  for (size_t j = 0; j < num_fields; ++j) {
+    const auto field =
+        mysql_fetch_field_direct(meta.get(), static_cast<unsigned int>(j));
+    const auto hint = j < hints_.size() ? hints_[j] : BufferType::string;
+
+    auto& col = cols_[j];
+    auto& b = binds_[j];
+
+    switch (field->type) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_YEAR:
+        if (hint == BufferType::int64) {
+          col.type = BufferType::int64;
+        }
+        break;
+
+      case MYSQL_TYPE_FLOAT:
+      case MYSQL_TYPE_DOUBLE:
+        if (hint == BufferType::float64) {
+          col.type = BufferType::float64;
+        }
+        break;
+
+      case MYSQL_TYPE_DATE:
+      case MYSQL_TYPE_DATETIME:
+      case MYSQL_TYPE_TIMESTAMP:
+        if (hint == BufferType::datetime) {
+          col.type = BufferType::datetime;
+        }
+        break;
+
+      default:
+        break;
+    }
+
+    b.is_null = &col.is_null;
+    b.length = &col.length;
+    b.error = &col.error;
 
-  const unsigned int num_fields = mysql_num_fields(res_.get());
+    switch (col.type) {
+      case BufferType::int64:
+        b.buffer_type = MYSQL_TYPE_LONGLONG;
+        b.buffer = &col.int64;
+        b.is_unsigned = (field->flags & UNSIGNED_FLAG) ? 1 : 0;
+        break;
+
+      case BufferType::float64:
+        b.buffer_type = MYSQL_TYPE_DOUBLE;
+        b.buffer = &col.float64;
+        break;
+
+      case BufferType::datetime:
+        b.buffer_type = MYSQL_TYPE_DATETIME;
+        b.buffer = &col.time;
+        break;
+
+      case BufferType::string:
+        // Larger values are fetched separately in push_back(...).
+        col.str.resize(std::min<unsigned long>(
+            std::max<unsigned long>(field->length, 1), 256));
+        b.buffer_type = MYSQL_TYPE_STRING;
+        b.buffer = col.str.data();
+        b.buffer_length = static_cast<unsigned long>(col.str.size());
+        break;
+    }
+  }
+
+  if (mysql_stmt_bind_result(stmt_.get(), binds_.data())) {
+    return make_error(stmt_.get());
+  }
+
+  bound_ = true;
+
+  return Nothing{};
+}
+
+Result<RowBatch> Iterator::next(const size_t _batch_size) {
+  if (!bound_) {
+    const auto res = bind();
+    if (!res) {
+      end_ = true;
+      return error(res.error().what());
+    }
+  }
+
+  RowBatch batch(cols_.size());
 
   for (size_t i = 0; i < _batch_size; ++i) {
-    MYSQL_ROW row = mysql_fetch_row(res_.get());
+    const auto rc = mysql_stmt_fetch(stmt_.get());
 
-    if (!row) {
-      const auto err = mysql_error(conn_.get());
-      if (*err) {
-        return error(err);
-      }
+    if (rc == MYSQL_NO_DATA) {
+      end_ = true;
+      return batch;
+    }
+
+    if (rc != 0 && rc != MYSQL_DATA_TRUNCATED) {
       end_ = true;
-      return vec;
+      return make_error(stmt_.get());
     }
 
-    std::vector<std::optional<std::string>> res_row(num_fields);
+    for (size_t j = 0; j < cols_.size(); ++j) {
+      const auto res = push_back(j, &batch);
+      if (!res) {
+        end_ = true;
+        return error(res.error().what());
+      }
+    }
+  }
 
-    for (unsigned int j = 0; j < num_fields; ++j) {
-      if (row[j]) {
-        res_row[j] = std::string(row[j]);
-      } else {
-        res_row[j] = std::nullopt;
+  return batch;
+}
+
+Result<Nothing> Iterator::push_back(const size_t _j, RowBatch* _batch) {
+  auto& col = cols_[_j];
+
+  if (col.is_null) {
+    _batch->push_null();
+    return Nothing{};
+  }
+
+  switch (col.type) {
+    case BufferType::int64:
+      _batch->push_int64(col.int64);
+      return Nothing{};
+
+    case BufferType::float64:
+      _batch->push_float64(col.float64);
+      return Nothing{};
+
+    case BufferType::datetime: {
+      const auto& t = col.time;
+      if (t.month == 0 || t.day == 0) {
+        _batch->push_back("0000-00-00 00:00:00");
+        return Nothing{};
       }
+      using namespace std::chrono;
+      const auto d = sys_days(year_month_day(
+          year(static_cast<int>(t.year)), month(t.month), day(t.day)));
+      const auto tp = d + hours(t.hour) + minutes(t.minute) +
+                      seconds(t.second) + microseconds(t.second_part);
+      _batch->push_timestamp(
+          duration_cast<microseconds>(tp.time_since_epoch()).count());
+      return Nothing{};
     }
 
-    vec.emplace_back(std::move(res_row));
+    case BufferType::string:
+      if (col.length > col.str.size()) {
+        col.str.resize(col.length);
+        binds_[_j].buffer = col.str.data();
+        binds_[_j].buffer_length = col.length;
+        if (mysql_stmt_fetch_column(stmt_.get(), &binds_[_j],
+                                    static_cast<unsigned int>(_j), 0)) {
+          return make_error(stmt_.get());
+        }
+        if (mysql_stmt_bind_result(stmt_.get(), binds_.data())) {
+          return make_error(stmt_.get());
+        }
+      }
+      _batch->push_back(std::string_view(col.str.data(), col.length));
+      return Nothing{};
   }
 
-  return vec;
+  return Nothing{};
+}
+
+void Iterator::set_column_types(const std::vector<dynamic::Type>& _types) {
+  hints_.clear();
+  for (const auto& type : _types) {
+    hints_.push_back(type.visit([](const auto& _t) {
+      using T = std::remove_cvref_t<decltype(_t)>;
+      if constexpr (std::is_same_v<T, dynamic::types::Boolean> ||
+                    std::is_same_v<T, dynamic::types::Int8> ||
+                    std::is_same_v<T, dynamic::types::Int16> ||
+                    std::is_same_v<T, dynamic::types::Int32> ||
+                    std::is_same_v<T, dynamic::types::Int64> ||
+                    std::is_same_v<T, dynamic::types::UInt8> ||
+                    std::is_same_v<T, dynamic::types::UInt16> ||
+                    std::is_same_v<T, dynamic::types::UInt32> ||
+                    std::is_same_v<T, dynamic::types::UInt64>) {
+        return BufferType::int64;
+      } else if constexpr (std::is_same_v<T, dynamic::types::Float32> ||
+                           std::is_same_v<T, dynamic::types::Float64>) {
+        return BufferType::float64;
+      } else if constexpr (std::is_same_v<T, dynamic::types::Date> ||
+                           std::is_same_v<T, dynamic::types::Timestamp> ||
+                           std::is_same_v<T,
+                                          dynamic::types::TimestampWithTZ>) {
+        return BufferType::datetime;
+      } else {
+        return BufferType::string;
+      }
+    }));
+  }
 }
 
 }  // namespace sqlgen::mysql
@@ -1,5 +1,6 @@
 #include "sqlgen/mysql/to_sql.hpp"
 
+#include <algorithm>
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
@@ -170,7 +171,13 @@ std::string column_or_value_to_sql(
     const dynamic::ColumnOrValue& _col) noexcept {
   const auto handle_value = [](const auto& _v) -> std::string {
     using Type = std::remove_cvref_t<decltype(_v)>;
-    if constexpr (std::is_same_v<Type, dynamic::String>) {
+    if constexpr (std::is_same_v<Type, dynamic::Param>) {
+      // MySQL only supports positional placeholders, so the position of
+      // the parameter is kept in a comment, from which the connection
+      // recovers the order in which the values need to be bound.
+      return "?/*" + std::to_string(_v.ix) + "*/";
+
+    } else if constexpr (std::is_same_v<Type, dynamic::String>) {
       return "'" + escape_single_quote(_v.val) + "'";
 
     } else if constexpr (std::is_same_v<Type, dynamic::Duration>) {
@@ -546,11 +553,21 @@ std::string insert_or_write_to_sql(const InsertOrWrite& _stmt) noexcept {
       internal::collect::vector(_stmt.columns | transform(wrap_in_quotes)));
   stream << ")";
 
-  stream << " VALUES (";
-  stream << internal::strings::join(
-      ", ",
-      internal::collect::vector(_stmt.columns | transform(to_questionmark)));
-  stream << ")";
+  const auto row =
+      "(" +
+      internal::strings::join(
+          ", ", internal::collect::vector(_stmt.columns |
+                                          transform(to_questionmark))) +
+      ")";
+
+  stream << " VALUES ";
+  for (size_t i = 0; i < std::max<size_t>(_stmt.num_rows, 1); ++i) {
+    if (i != 0) {
+      stream << ", ";
+    }
+    stream << row;
+  }
+
   if constexpr (std::is_same_v<InsertOrWrite, dynamic::Insert>) {
     if (_stmt.or_replace) {
       stream << " ON DUPLICATE KEY UPDATE ";
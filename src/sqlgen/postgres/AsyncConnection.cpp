@@ -0,0 +1,170 @@
+#include "sqlgen/postgres/AsyncConnection.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "sqlgen/postgres/Connection.hpp"
+#include "sqlgen/postgres/ResultIterator.hpp"
+#include "sqlgen/postgres/exec.hpp"
+
+namespace sqlgen::postgres {
+
+Task<Result<Ref<AsyncConnection>>> AsyncConnection::connect(
+    EventLoop* _loop, const Credentials _credentials) {
+  const auto raw_ptr = PQconnectStart(_credentials.to_str().c_str());
+  if (!raw_ptr) {
+    co_return error("Connection to postgres failed: Out of memory.");
+  }
+
+  const auto conn =
+      ConnPtr::make(std::shared_ptr<PGconn>(raw_ptr, &PQfinish)).value();
+
+  // As required by libpq, we wait for the socket to become writable before
+  // the first call to PQconnectPoll.
+  auto status = PGRES_POLLING_WRITING;
+  while (status != PGRES_POLLING_OK) {
+    if (status == PGRES_POLLING_FAILED || PQstatus(raw_ptr) == CONNECTION_BAD) {
+      co_return error(std::string("Connection to postgres failed: ") +
+                      PQerrorMessage(raw_ptr));
+    }
+    const auto waited = co_await _loop->wait(
+        PQsocket(raw_ptr), status == PGRES_POLLING_READING
+                               ? EventLoop::Interest::read
+                               : EventLoop::Interest::write);
+    if (!waited) {
+      co_return error(waited.error().what());
+    }
+    status = PQconnectPoll(raw_ptr);
+  }
+
+  if (PQsetnonblocking(raw_ptr, 1) != 0) {
+    co_return error(std::string("Could not switch to non-blocking mode: ") +
+                    PQerrorMessage(raw_ptr));
+  }
+
+  co_return Ref<AsyncConnection>::make(conn, _loop);
+}
+
+Task<Result<Nothing>> AsyncConnection::execute(const std::string _sql) {
+  const auto res = co_await query(_sql, std::nullopt);
+  co_return res.transform([](const auto&) { return Nothing{}; });
+}
+
+Task<Result<Nothing>> AsyncConnection::execute(const std::string _sql,
+                                               const RowBatch _params) {
+  const auto params = Connection::to_params(_params);
+  if (!params) {
+    co_return error(params.error().what());
+  }
+  const auto res = co_await query(_sql, *params);
+  co_return res.transform([](const auto&) { return Nothing{}; });
+}
+
+Task<Result<Nothing>> AsyncConnection::flush() {
+  while (true) {
+    const int flushed = PQflush(conn_.get());
+    if (flushed == 0) {
+      co_return Nothing{};
+    }
+    if (flushed < 0) {
+      co_return error(PQerrorMessage(conn_.get()));
+    }
+    // The server might not read the rest of the query before we have read
+    // what it sent us, so we have to wait for both.
+    const auto waited = co_await loop_->wait(
+        PQsocket(conn_.get()), EventLoop::Interest::read_or_write);
+    if (!waited) {
+      co_return waited;
+    }
+    if (PQconsumeInput(conn_.get()) == 0) {
+      co_return error(PQerrorMessage(conn_.get()));
+    }
+  }
+}
+
+Task<Result<Ref<PGresult>>> AsyncConnection::query(
+    const std::string _sql,
+    const std::optional<std::vector<std::optional<std::string>>> _params) {
+  int sent = 0;
+
+  if (_params) {
+    std::vector<const char*> values;
+    for (const auto& param : *_params) {
+      values.push_back(param ? param->c_str() : nullptr);
+    }
+    sent = PQsendQueryParams(conn_.get(),                      // conn
+                             _sql.c_str(),                     // command
+                             static_cast<int>(values.size()),  // nParams
+                             nullptr,                          // paramTypes
+                             values.data(),                    // paramValues
+                             nullptr,                          // paramLengths
+                             nullptr,                          // paramFormats
+                             0                                 // resultFormat
+    );
+  } else {
+    sent = PQsendQuery(conn_.get(), _sql.c_str());
+  }
+
+  if (sent == 0) {
+    co_return error("Executing '" + _sql +
+                    "' failed: " + PQerrorMessage(conn_.get()));
+  }
+
+  const auto flushed = co_await flush();
+  if (!flushed) {
+    co_return error(flushed.error().what());
+  }
+
+  co_return co_await receive(_sql);
+}
+
+Task<Result<Ref<IteratorBase>>> AsyncConnection::read(
+    const std::string _sql, const RowBatch _params) {
+  const auto params = Connection::to_params(_params);
+  if (!params) {
+    co_return error(params.error().what());
+  }
+  const auto res = co_await query(_sql, *params);
+  co_return res.transform([](const auto& _res) {
+    return Ref<IteratorBase>(Ref<ResultIterator>::make(_res));
+  });
+}
+
+Task<Result<Ref<PGresult>>> AsyncConnection::receive(const std::string _sql) {
+  std::optional<Result<Ref<PGresult>>> result;
+
+  while (true) {
+    while (PQisBusy(conn_.get())) {
+      const auto waited = co_await loop_->wait(PQsocket(conn_.get()),
+                                               EventLoop::Interest::read);
+      if (!waited) {
+        co_return error(waited.error().what());
+      }
+      if (PQconsumeInput(conn_.get()) == 0) {
+        co_return error(PQerrorMessage(conn_.get()));
+      }
+    }
+
+    const auto res = PQgetResult(conn_.get());
+    if (!res) {
+      break;
+    }
+
+    // Once there is an error, we keep it, but still have to collect the
+    // remaining results, before the connection can be used again.
+    auto wrapped = wrap_result(res, _sql);
+    if (!result || *result) {
+      result = std::move(wrapped);
+    }
+  }
+
+  if (!result) {
+    co_return error("Executing '" + _sql + "' returned no result.");
+  }
+
+  co_return std::move(*result);
+}
+
+}  // namespace sqlgen::postgres
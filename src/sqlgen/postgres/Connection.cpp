@@ -1,87 +1,359 @@
 #include "sqlgen/postgres/Connection.hpp"
 
+#include <algorithm>
+#include <array>
+#include <optional>
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
 
-#include "sqlgen/internal/collect/vector.hpp"
-#include "sqlgen/internal/strings/strings.hpp"
+#include "sqlgen/internal/native_to_text.hpp"
+#include "sqlgen/postgres/CopyIterator.hpp"
 #include "sqlgen/postgres/Iterator.hpp"
+#include "sqlgen/postgres/StreamingIterator.hpp"
+#include "sqlgen/postgres/binary.hpp"
 
 namespace sqlgen::postgres {
 
+void Connection::abort_copy(const std::string& _msg) noexcept {
+  PQsetnonblocking(conn_.get(), 0);
+  PQputCopyEnd(conn_.get(), _msg.c_str());
+  while (const auto res = PQgetResult(conn_.get())) {
+    PQclear(res);
+  }
+  copy_types_.clear();
+  copy_buffer_.clear();
+  copy_aborted_ = true;
+}
+
 Result<Nothing> Connection::begin_transaction() noexcept {
   return execute("BEGIN TRANSACTION;");
 }
 
 Result<Nothing> Connection::commit() noexcept { return execute("COMMIT;"); }
 
+Result<Nothing> Connection::deallocate_stale_statements() noexcept {
+  Result<Nothing> res = Nothing{};
+  std::vector<std::string> failed;
+  for (const auto& name : *stale_stmts_) {
+    const auto deallocated = execute("DEALLOCATE " + name + ";");
+    if (!deallocated) {
+      if (res) {
+        res = deallocated;
+      }
+      // The statement still exists on the server, so we try again next
+      // time.
+      failed.push_back(name);
+    }
+  }
+  *stale_stmts_ = std::move(failed);
+  return res;
+}
+
 Result<Nothing> Connection::end_write() {
+  if (copy_aborted_) {
+    copy_aborted_ = false;
+    return error("The write operation has been aborted, because a call to "
+                 ".write(...) failed.");
+  }
+
+  if (copy_types_.size() != 0) {
+    copy_types_.clear();
+    // The trailer of the binary format is a field count of -1.
+    copy_buffer_.append("\xff\xff");
+  }
+
+  const auto flushed = flush_copy_buffer().and_then(
+      [&](auto&&) { return wait_until_sent(); });
+
+  if (!flushed) {
+    // Some of the rows might not have reached the server, so none of them
+    // must be written.
+    abort_copy(flushed.error().what());
+    copy_aborted_ = false;
+    return flushed;
+  }
+
+  PQsetnonblocking(conn_.get(), 0);
+
   if (PQputCopyEnd(conn_.get(), NULL) == -1) {
     return error(PQerrorMessage(conn_.get()));
   }
-  const auto res = PQgetResult(conn_.get());
-  if (PQresultStatus(res) != PGRES_COMMAND_OK) {
-    return error(PQerrorMessage(conn_.get()));
+
+  // Reads all results, so the connection can be used again. Only the first
+  // error is reported.
+  std::optional<std::string> err;
+  while (const auto res = PQgetResult(conn_.get())) {
+    if (PQresultStatus(res) != PGRES_COMMAND_OK && !err) {
+      err = PQresultErrorMessage(res);
+    }
+    PQclear(res);
   }
+
+  if (err) {
+    return error(*err);
+  }
+
   return Nothing{};
 }
 
-Result<Nothing> Connection::insert(
-    const dynamic::Insert& _stmt,
-    const std::vector<std::vector<std::optional<std::string>>>&
-        _data) noexcept {
+Result<Nothing> Connection::execute(const std::string& _sql,
+                                    const RowBatch& _params) noexcept {
+  return to_params(_params)
+      .and_then([&](const auto& _p) {
+        return use_statement(_sql, _p.size()).and_then([&](const auto& _name) {
+          return exec_prepared(conn_, _name, _p);
+        });
+      })
+      .transform([](auto&&) { return Nothing{}; });
+}
+
+Result<Nothing> Connection::execute_many(
+    const std::vector<std::string>& _sqls) noexcept {
+  if (_sqls.size() == 0) {
+    return Nothing{};
+  }
+
+  if (PQenterPipelineMode(conn_.get()) != 1) {
+    return error(PQerrorMessage(conn_.get()));
+  }
+
+  Result<Nothing> res = Nothing{};
+
+  for (size_t i = 0; i < _sqls.size(); ++i) {
+    const auto sent = PQsendQueryParams(conn_.get(), _sqls[i].c_str(), 0,
+                                        nullptr, nullptr, nullptr, nullptr, 0);
+    if (!sent) {
+      res = error(PQerrorMessage(conn_.get()));
+      break;
+    }
+    if ((i + 1) % pipeline_depth_ == 0) {
+      res = sync_pipeline();
+      if (!res) {
+        break;
+      }
+    }
+  }
+
+  const auto synced = sync_pipeline();
+
+  PQexitPipelineMode(conn_.get());
+
+  return res ? synced : res;
+}
+
+Result<Nothing> Connection::insert(const dynamic::Insert& _stmt,
+                                   const RowBatch& _data) noexcept {
   if (_data.size() == 0) {
     return Nothing{};
   }
 
-  const auto sql = to_sql_impl(_stmt);
+  const auto rows = rows_to_insert(_stmt, _data);
+
+  const auto num_cols = _data.num_cols();
+
+  // Every statement inserts as many rows as the parameter limit allows. If
+  // the number of rows is not a multiple of that, the remaining rows are
+  // inserted by a second, shorter statement.
+  const auto rows_per_stmt = std::min(
+      rows.size(), std::max(max_params_ / std::max<size_t>(num_cols, 1),
+                            static_cast<size_t>(1)));
+
+  const auto num_remaining = rows.size() % rows_per_stmt;
+
+  const auto get_stmt_name = [&](const size_t _num_rows) {
+    auto stmt = _stmt;
+    stmt.num_rows = _num_rows;
+    return get_statement(to_sql_impl(stmt),
+                         static_cast<int>(_num_rows * num_cols));
+  };
+
+  const auto full_stmt = get_stmt_name(rows_per_stmt);
+  if (!full_stmt) {
+    return error(full_stmt.error().what());
+  }
+
+  const auto rest_stmt = num_remaining != 0
+                             ? get_stmt_name(num_remaining)
+                             : Result<std::string>(std::string());
+  if (!rest_stmt) {
+    return error(rest_stmt.error().what());
+  }
+
+  std::vector<const char*> params(rows_per_stmt * num_cols);
 
-  const auto res = execute("PREPARE \"sqlgen_insert_into_table\" AS " + sql);
+  // Native values are formatted into these buffers.
+  std::vector<std::array<char, 32>> buffers(params.size());
+
+  // The statements are sent in pipeline mode, so we only wait for the server
+  // once every pipeline_depth_ statements, instead of once per statement.
+  if (PQenterPipelineMode(conn_.get()) != 1) {
+    return error(PQerrorMessage(conn_.get()));
+  }
+
+  Result<Nothing> res = Nothing{};
+
+  size_t num_sent = 0;
+
+  for (size_t begin = 0; res && begin < rows.size(); begin += rows_per_stmt) {
+    const auto end = std::min(begin + rows_per_stmt, rows.size());
+
+    size_t k = 0;
+
+    for (size_t i = begin; res && i < end; ++i) {
+      const auto row = _data[rows[i]];
+
+      for (size_t j = 0; j < num_cols; ++j, ++k) {
+        const auto cell = row[j];
+        if (cell.is_null()) {
+          params[k] = nullptr;
+        } else if (cell.is_native()) {
+          auto& buf = buffers[k];
+          const auto str = internal::native_to_text(cell, &buf);
+          if (!str) {
+            res = error(str.error().what());
+            break;
+          }
+          buf[str->size()] = '\0';
+          params[k] = buf.data();
+        } else {
+          // Text values are NUL-terminated in the arena of the RowBatch.
+          params[k] = cell.text().data();
+        }
+      }
+    }
+
+    if (!res) {
+      break;
+    }
+
+    const auto& stmt_name =
+        end - begin == rows_per_stmt ? *full_stmt : *rest_stmt;
+
+    const auto sent =
+        PQsendQueryPrepared(conn_.get(),          // conn
+                            stmt_name.c_str(),    // stmtName
+                            static_cast<int>(k),  // nParams
+                            params.data(),        // paramValues
+                            nullptr,              // paramLengths
+                            nullptr,              // paramFormats
+                            0                     // resultFormat
+        );
+
+    if (!sent) {
+      res = error(PQerrorMessage(conn_.get()));
+      break;
+    }
+
+    if (++num_sent % pipeline_depth_ == 0) {
+      res = sync_pipeline();
+    }
+  }
+
+  const auto synced = sync_pipeline();
+
+  PQexitPipelineMode(conn_.get());
+
+  // If the cache is disabled, the statements are not needed anymore.
+  if (stmt_cache_.capacity() == 0) {
+    stale_stmts_->push_back(*full_stmt);
+    if (num_remaining != 0) {
+      stale_stmts_->push_back(*rest_stmt);
+    }
+  }
+
+  const auto deallocated = deallocate_stale_statements();
 
   if (!res) {
     return res;
   }
 
-  std::vector<const char*> current_row(_data[0].size());
+  if (!synced) {
+    return error(std::string("Executing INSERT failed: ") +
+                 synced.error().what());
+  }
+
+  return deallocated;
+}
 
-  const int n_params = static_cast<int>(current_row.size());
+std::vector<size_t> Connection::rows_to_insert(const dynamic::Insert& _stmt,
+                                               const RowBatch& _data) {
+  std::vector<size_t> rows;
+  rows.reserve(_data.size());
 
-  for (size_t i = 0; i < _data.size(); ++i) {
-    const auto& d = _data[i];
+  if (!_stmt.or_replace) {
+    for (size_t i = 0; i < _data.size(); ++i) {
+      rows.push_back(i);
+    }
+    return rows;
+  }
 
-    if (d.size() != current_row.size()) {
-      execute("DEALLOCATE sqlgen_insert_into_table;");
-      return error("Error in entry " + std::to_string(i) + ": Expected " +
-                   std::to_string(current_row.size()) + " entries, got " +
-                   std::to_string(d.size()));
+  std::vector<size_t> key_cols;
+  for (size_t j = 0; j < _stmt.columns.size(); ++j) {
+    if (std::ranges::find(_stmt.constraints, _stmt.columns[j]) !=
+        _stmt.constraints.end()) {
+      key_cols.push_back(j);
     }
+  }
 
-    for (size_t j = 0; j < d.size(); ++j) {
-      current_row[j] = d[j] ? d[j]->c_str() : nullptr;
+  // Going backwards, so the last row with a given key is the one we see
+  // first.
+  std::unordered_set<std::string> keys;
+  std::string key;
+  for (size_t i = _data.size(); i > 0; --i) {
+    const auto row = _data[i - 1];
+    key.clear();
+    bool has_null = false;
+    for (const auto j : key_cols) {
+      const auto cell = row[j];
+      // NULLs never conflict with each other.
+      has_null = has_null || cell.is_null();
+      const auto bytes = cell.text();
+      const auto len = bytes.size();
+      key.push_back(static_cast<char>(cell.kind()));
+      key.append(reinterpret_cast<const char*>(&len), sizeof(len));
+      key.append(bytes);
+    }
+    if (has_null || keys.insert(key).second) {
+      rows.push_back(i - 1);
     }
+  }
 
-    const auto res = PQexecPrepared(conn_.get(),                 // conn
-                                    "sqlgen_insert_into_table",  // stmtName
-                                    n_params,                    // nParams
-                                    current_row.data(),          // paramValues
-                                    nullptr,                     // paramLengths
-                                    nullptr,                     // paramFormats
-                                    0                            // resultFormat
-    );
+  std::ranges::reverse(rows);
 
-    const auto status = PQresultStatus(res);
+  return rows;
+}
 
+Result<std::string> Connection::get_statement(const std::string& _sql,
+                                              const int _num_params) noexcept {
+  return stmt_cache_.get(_sql, [&](const std::string&) -> Result<std::string> {
+    const auto name = "sqlgen_stmt_" + std::to_string(++num_stmts_);
+    const auto res = PQprepare(conn_.get(), name.c_str(), _sql.c_str(),
+                               _num_params, nullptr);
+    const auto status = PQresultStatus(res);
+    const auto msg = std::string(PQresultErrorMessage(res));
+    PQclear(res);
     if (status != PGRES_COMMAND_OK) {
-      const auto err = error(std::string("Executing INSERT failed: ") +
-                             PQresultErrorMessage(res));
-      execute("DEALLOCATE sqlgen_insert_into_table;");
-      return err;
+      return error("Preparing '" + _sql + "' failed: " + msg);
     }
-  }
+    return name;
+  });
+}
 
-  return execute("DEALLOCATE sqlgen_insert_into_table;");
+Result<std::vector<Oid>> Connection::get_column_types(
+    const dynamic::Write& _stmt) noexcept {
+  return exec(conn_, write_types_to_sql(_stmt)).transform([](auto&& _res) {
+    const auto num_cols = PQnfields(_res.get());
+    std::vector<Oid> types(static_cast<size_t>(num_cols));
+    for (int j = 0; j < num_cols; ++j) {
+      types[static_cast<size_t>(j)] = PQftype(_res.get(), j);
+    }
+    return types;
+  });
 }
 
 rfl::Result<Ref<Connection>> Connection::make(
@@ -107,10 +379,79 @@ typename Connection::ConnPtr Connection::make_conn(
   return ConnPtr::make(std::shared_ptr<PGconn>(raw_ptr, &PQfinish)).value();
 }
 
+Result<Nothing> Connection::flush_copy_buffer() noexcept {
+  if (copy_buffer_.size() == 0) {
+    return Nothing{};
+  }
+
+  // Makes sure the previous chunk has been sent, so that libpq never holds
+  // more than one chunk.
+  const auto waited = wait_until_sent();
+  if (!waited) {
+    return waited;
+  }
+
+  if (PQputCopyData(conn_.get(), copy_buffer_.data(),
+                    static_cast<int>(copy_buffer_.size())) != 1) {
+    return error("Error occurred while writing data to postgres: " +
+                 std::string(PQerrorMessage(conn_.get())));
+  }
+
+  copy_buffer_.clear();
+
+  ++num_copy_chunks_;
+
+  // Sends as much as the socket accepts without blocking, the rest is sent
+  // while the next chunk is being serialized.
+  if (PQflush(conn_.get()) == -1) {
+    return error(PQerrorMessage(conn_.get()));
+  }
+
+  return Nothing{};
+}
+
 Result<Ref<IteratorBase>> Connection::read(const dynamic::SelectFrom& _query) {
-  const auto sql = postgres::to_sql_impl(_query);
+  return read(postgres::to_sql_impl(_query), RowBatch());
+}
+
+Result<Ref<IteratorBase>> Connection::read(const std::string& _sql,
+                                          const RowBatch& _params) {
+  if (_params.size() != 0) {
+    return read_with_params(_sql, _params);
+  }
+  try {
+    if (credentials_.read_mode == ReadMode::copy) {
+      return Ref<IteratorBase>(Ref<CopyIterator>::make(
+          _sql, conn_, credentials_.binary_results));
+    }
+    if (credentials_.read_mode == ReadMode::stream) {
+      return Ref<IteratorBase>(Ref<StreamingIterator>::make(
+          _sql, conn_, credentials_.binary_results));
+    }
+    return Ref<IteratorBase>(
+        Ref<Iterator>::make(_sql, conn_, credentials_.binary_results));
+  } catch (std::exception& e) {
+    return error(e.what());
+  }
+}
+
+Result<Ref<IteratorBase>> Connection::read_with_params(
+    const std::string& _sql, const RowBatch& _params) {
+  const auto params = to_params(_params);
+  if (!params) {
+    return error(params.error().what());
+  }
   try {
-    return Ref<IteratorBase>(Ref<Iterator>::make(sql, conn_));
+    if (credentials_.read_mode == ReadMode::cursor) {
+      return Ref<IteratorBase>(Ref<Iterator>::make(
+          _sql, conn_, credentials_.binary_results, *params));
+    }
+    const auto name = use_statement(_sql, params->size());
+    if (!name) {
+      return error(name.error().what());
+    }
+    return Ref<IteratorBase>(Ref<StreamingIterator>::make(
+        *name, *params, conn_, credentials_.binary_results));
   } catch (std::exception& e) {
     return error(e.what());
   }
@@ -118,35 +459,220 @@ Result<Ref<IteratorBase>> Connection::read(const dynamic::SelectFrom& _query) {
 
 Result<Nothing> Connection::rollback() noexcept { return execute("ROLLBACK;"); }
 
-std::string Connection::to_buffer(
-    const std::vector<std::optional<std::string>>& _line) const noexcept {
-  using namespace std::ranges::views;
+Result<Nothing> Connection::start_write(const dynamic::Write& _stmt) {
+  copy_aborted_ = false;
+  copy_types_.clear();
+  num_copy_chunks_ = 0;
+  copy_buffer_.clear();
+  copy_buffer_.reserve(credentials_.copy_buffer_size);
+
+  const auto types = credentials_.binary_copy
+                         ? get_column_types(_stmt)
+                         : Result<std::vector<Oid>>(std::vector<Oid>());
+  if (!types) {
+    return error(types.error().what());
+  }
+
+  const bool binary =
+      types->size() != 0 &&
+      std::all_of(types->begin(), types->end(), binary::is_encodable);
 
-  const auto edit_field =
-      [](const std::optional<std::string>& _field) -> std::string {
-    if (!_field) {
-      return "\e";
+  const auto res = execute(binary ? write_binary_to_sql(_stmt)
+                                  : postgres::to_sql_impl(_stmt));
+  if (!res) {
+    return res;
+  }
+
+  if (binary) {
+    // The signature, followed by the flags field and the length of the
+    // header extension area, both of which are zero.
+    constexpr auto header =
+        std::string_view("PGCOPY\n\xff\r\n\0\0\0\0\0\0\0\0\0", 19);
+    copy_buffer_.append(header);
+    copy_types_ = *types;
+  }
+
+  // In nonblocking mode, a chunk can be sent while the next one is being
+  // serialized.
+  if (PQsetnonblocking(conn_.get(), 1) != 0) {
+    const auto err = std::string(PQerrorMessage(conn_.get()));
+    abort_copy(err);
+    copy_aborted_ = false;
+    return error(err);
+  }
+
+  return Nothing{};
+}
+
+Result<Nothing> Connection::sync_pipeline() noexcept {
+  if (PQpipelineSync(conn_.get()) != 1) {
+    return error(PQerrorMessage(conn_.get()));
+  }
+
+  // Every query is followed by a nullptr, so we keep on reading until we
+  // reach the synchronization point. Only the first error is reported,
+  // because all subsequent queries are aborted anyway.
+  std::optional<std::string> err;
+
+  while (true) {
+    const auto res = PQgetResult(conn_.get());
+
+    if (!res) {
+      if (PQstatus(conn_.get()) == CONNECTION_BAD) {
+        return error(PQerrorMessage(conn_.get()));
+      }
+      continue;
+    }
+
+    const auto status = PQresultStatus(res);
+
+    if (status == PGRES_FATAL_ERROR && !err) {
+      err = PQresultErrorMessage(res);
     }
-    if (_field->find("\t") != std::string::npos) {
-      return "\a" + *_field + "\a";
+
+    PQclear(res);
+
+    if (status == PGRES_PIPELINE_SYNC) {
+      break;
     }
-    return *_field;
-  };
+  }
 
-  return internal::strings::join(
-             "\t", internal::collect::vector(_line | transform(edit_field))) +
-         "\n";
+  if (err) {
+    return error(*err);
+  }
+
+  return Nothing{};
+}
+
+Result<Nothing> Connection::to_buffer(const RowBatch::Row& _row,
+                                      std::string* _buffer) const noexcept {
+  std::array<char, 32> buf{};
+
+  for (size_t j = 0; j < _row.size(); ++j) {
+    if (j != 0) {
+      _buffer->push_back('\t');
+    }
+
+    const auto cell = _row[j];
+
+    if (cell.is_null()) {
+      _buffer->append("\e");
+      continue;
+    }
+
+    const auto field = cell.is_native()
+                           ? internal::native_to_text(cell, &buf)
+                           : Result<std::string_view>(cell.text());
+    if (!field) {
+      return error(field.error().what());
+    }
+
+    if (field->find('\t') != std::string_view::npos) {
+      _buffer->push_back('\a');
+      _buffer->append(*field);
+      _buffer->push_back('\a');
+    } else {
+      _buffer->append(*field);
+    }
+  }
+
+  _buffer->push_back('\n');
+
+  return Nothing{};
+}
+
+Result<Nothing> Connection::to_binary_buffer(
+    const RowBatch::Row& _row, std::string* _buffer) const noexcept {
+  if (_row.size() != copy_types_.size()) {
+    return error("Expected " + std::to_string(copy_types_.size()) +
+                 " fields, got " + std::to_string(_row.size()) + ".");
+  }
+
+  // Every tuple starts with the number of fields as a 16-bit integer.
+  _buffer->push_back(static_cast<char>((_row.size() >> 8) & 0xff));
+  _buffer->push_back(static_cast<char>(_row.size() & 0xff));
+
+  for (size_t j = 0; j < _row.size(); ++j) {
+    const auto res = binary::append(copy_types_[j], _row[j], _buffer);
+    if (!res) {
+      return res;
+    }
+  }
+
+  return Nothing{};
+}
+
+Result<std::vector<std::optional<std::string>>> Connection::to_params(
+    const RowBatch& _params) noexcept {
+  std::vector<std::optional<std::string>> params;
+  if (_params.size() == 0) {
+    return params;
+  }
+
+  std::array<char, 32> buf{};
+
+  const auto row = _params[0];
+  for (size_t j = 0; j < row.size(); ++j) {
+    const auto cell = row[j];
+    if (cell.is_null()) {
+      params.emplace_back(std::nullopt);
+    } else if (cell.is_native()) {
+      const auto field = internal::native_to_text(cell, &buf);
+      if (!field) {
+        return error(field.error().what());
+      }
+      params.emplace_back(std::string(*field));
+    } else {
+      params.emplace_back(std::string(cell.text()));
+    }
+  }
+
+  return params;
+}
+
+Result<std::string> Connection::use_statement(
+    const std::string& _sql, const size_t _num_params) noexcept {
+  const auto name = get_statement(_sql, static_cast<int>(_num_params));
+  if (!name) {
+    return name;
+  }
+  const auto deallocated = deallocate_stale_statements();
+  if (stmt_cache_.capacity() == 0) {
+    stale_stmts_->push_back(*name);
+  }
+  if (!deallocated) {
+    return error(deallocated.error().what());
+  }
+  return name;
+}
+
+Result<Nothing> Connection::wait_until_sent() noexcept {
+  // PQflush blocks until all data has been sent in blocking mode.
+  PQsetnonblocking(conn_.get(), 0);
+  const auto flushed = PQflush(conn_.get());
+  PQsetnonblocking(conn_.get(), 1);
+  if (flushed != 0) {
+    return error(PQerrorMessage(conn_.get()));
+  }
+  return Nothing{};
 }
 
-Result<Nothing> Connection::write(
-    const std::vector<std::vector<std::optional<std::string>>>& _data) {
-  for (const auto& line : _data) {
-    const auto buffer = to_buffer(line);
-    const auto success = PQputCopyData(conn_.get(), buffer.c_str(),
-                                       static_cast<int>(buffer.size()));
-    if (success != 1) {
-      PQputCopyEnd(conn_.get(), NULL);
-      return error("Error occurred while writing data to postgres.");
+Result<Nothing> Connection::write(const RowBatch& _data) {
+  for (size_t i = 0; i < _data.size(); ++i) {
+    const auto res = copy_types_.size() != 0
+                         ? to_binary_buffer(_data[i], &copy_buffer_)
+                         : to_buffer(_data[i], &copy_buffer_);
+    if (!res) {
+      abort_copy(res.error().what());
+      return res;
+    }
+
+    if (copy_buffer_.size() >= credentials_.copy_buffer_size) {
+      const auto flushed = flush_copy_buffer();
+      if (!flushed) {
+        abort_copy(flushed.error().what());
+        return flushed;
+      }
     }
   }
   return Nothing{};
@@ -0,0 +1,338 @@
+#include "sqlgen/postgres/CopyIterator.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "sqlgen/postgres/binary.hpp"
+
+namespace sqlgen::postgres {
+
+CopyIterator::CopyIterator(const std::string& _sql, const ConnPtr& _conn,
+                           const bool _binary)
+    : conn_(_conn),
+      end_(false),
+      binary_(_binary),
+      header_parsed_(false),
+      in_transaction_(false),
+      received_all_(false),
+      sent_(false),
+      sql_(_sql) {
+  while (!sql_.empty() && (sql_.back() == ';' || sql_.back() == ' ' ||
+                           sql_.back() == '\n')) {
+    sql_.pop_back();
+  }
+
+  // We need to know the number of columns and their types before the first
+  // row arrives, so the query is described first. This also means that
+  // errors in the query are reported right away. The COPY itself is only
+  // sent once the first batch is requested, so the column types passed to
+  // set_column_types(...) can still be taken into account.
+  using ResultPtr = std::unique_ptr<PGresult, decltype(&PQclear)>;
+
+  const auto prepared = ResultPtr(
+      PQprepare(conn_.get(), "", sql_.c_str(), 0, nullptr), &PQclear);
+  if (PQresultStatus(prepared.get()) != PGRES_COMMAND_OK) {
+    throw std::runtime_error(PQresultErrorMessage(prepared.get()));
+  }
+
+  const auto described =
+      ResultPtr(PQdescribePrepared(conn_.get(), ""), &PQclear);
+  if (PQresultStatus(described.get()) != PGRES_COMMAND_OK) {
+    throw std::runtime_error(PQresultErrorMessage(described.get()));
+  }
+
+  const int num_cols = PQnfields(described.get());
+  for (int j = 0; j < num_cols; ++j) {
+    oids_.push_back(PQftype(described.get(), j));
+  }
+}
+
+CopyIterator::~CopyIterator() { shutdown(); }
+
+bool CopyIterator::end() const { return end_; }
+
+Result<Nothing> CopyIterator::finish() noexcept {
+  received_all_ = true;
+
+  std::string err;
+
+  while (true) {
+    const auto res = PQgetResult(conn_.get());
+    if (!res) {
+      break;
+    }
+    if (PQresultStatus(res) != PGRES_COMMAND_OK && err.empty()) {
+      err = PQresultErrorMessage(res);
+    }
+    PQclear(res);
+  }
+
+  if (!err.empty()) {
+    return error(err);
+  }
+
+  return Nothing{};
+}
+
+Result<RowBatch> CopyIterator::next(const size_t _batch_size) {
+  if (end()) {
+    return error("End is reached.");
+  }
+
+  if (!sent_) {
+    const auto res = send();
+    if (!res) {
+      end_ = true;
+      return error(res.error().what());
+    }
+  }
+
+  RowBatch batch(oids_.size());
+
+  while (batch.size() < _batch_size) {
+    char* buf = nullptr;
+
+    // Every call returns exactly one row of the text format. In the binary
+    // format, the first row also contains the header and the last one the
+    // trailer. Blocks until the row has arrived.
+    const int len = PQgetCopyData(conn_.get(), &buf, 0);
+
+    if (len == -1) {
+      end_ = true;
+      const auto res = finish();
+      if (!res) {
+        return error(res.error().what());
+      }
+      break;
+    }
+
+    if (len < 0) {
+      end_ = true;
+      const auto msg = std::string(PQerrorMessage(conn_.get()));
+      finish();
+      return error(msg);
+    }
+
+    const auto msg = std::string_view(buf, static_cast<size_t>(len));
+
+    const auto res =
+        binary_ ? parse_binary(msg, &batch) : parse_text(msg, &batch);
+
+    PQfreemem(buf);
+
+    if (!res) {
+      shutdown();
+      return error(res.error().what());
+    }
+  }
+
+  return batch;
+}
+
+Result<Nothing> CopyIterator::parse_binary(std::string_view _msg,
+                                           RowBatch* _batch) {
+  const auto read_int = [&](const size_t _len) -> std::int64_t {
+    std::uint64_t val = 0;
+    for (size_t i = 0; i < _len; ++i) {
+      val = (val << 8) | static_cast<unsigned char>(_msg[i]);
+    }
+    _msg.remove_prefix(_len);
+    return _len == 2 ? static_cast<std::int16_t>(val)
+                     : static_cast<std::int32_t>(val);
+  };
+
+  if (!header_parsed_) {
+    // The signature, the flags field and the length of the header
+    // extension area, followed by the extension area itself.
+    constexpr auto signature = std::string_view("PGCOPY\n\xff\r\n\0", 11);
+    if (_msg.size() < 19 || _msg.substr(0, 11) != signature) {
+      return error("Invalid header in the binary COPY format.");
+    }
+    _msg.remove_prefix(15);
+    const auto ext_len = static_cast<size_t>(read_int(4));
+    if (_msg.size() < ext_len) {
+      return error("Invalid header in the binary COPY format.");
+    }
+    _msg.remove_prefix(ext_len);
+    header_parsed_ = true;
+  }
+
+  while (_msg.size() >= 2) {
+    const auto num_fields = read_int(2);
+
+    // The trailer is a field count of -1.
+    if (num_fields == -1) {
+      return Nothing{};
+    }
+
+    if (static_cast<size_t>(num_fields) != oids_.size()) {
+      return error("Expected " + std::to_string(oids_.size()) +
+                   " fields, got " + std::to_string(num_fields) + ".");
+    }
+
+    for (size_t j = 0; j < oids_.size(); ++j) {
+      if (_msg.size() < 4) {
+        return error("Unexpected end of a tuple in the binary COPY format.");
+      }
+      const auto field_len = read_int(4);
+      if (field_len == -1) {
+        _batch->push_null();
+        continue;
+      }
+      if (field_len < 0 || _msg.size() < static_cast<size_t>(field_len)) {
+        return error("Unexpected end of a tuple in the binary COPY format.");
+      }
+      binary::push_back(oids_[j], _msg.data(),
+                        static_cast<size_t>(field_len), _batch);
+      _msg.remove_prefix(static_cast<size_t>(field_len));
+    }
+  }
+
+  return Nothing{};
+}
+
+Result<Nothing> CopyIterator::parse_text(std::string_view _msg,
+                                         RowBatch* _batch) {
+  if (!_msg.empty() && _msg.back() == '\n') {
+    _msg.remove_suffix(1);
+  }
+
+  size_t num_fields = 0;
+
+  while (true) {
+    const auto pos = _msg.find('\t');
+    const auto field = _msg.substr(0, pos);
+
+    if (field == "\\N") {
+      _batch->push_null();
+    } else if (field.find('\\') == std::string_view::npos) {
+      _batch->push_back(field);
+    } else {
+      // Backslashes introduce escape sequences, everything else is taken
+      // literally.
+      unescaped_.clear();
+      for (size_t i = 0; i < field.size(); ++i) {
+        if (field[i] != '\\' || i + 1 == field.size()) {
+          unescaped_.push_back(field[i]);
+          continue;
+        }
+        switch (field[++i]) {
+          case 'b':
+            unescaped_.push_back('\b');
+            break;
+          case 'f':
+            unescaped_.push_back('\f');
+            break;
+          case 'n':
+            unescaped_.push_back('\n');
+            break;
+          case 'r':
+            unescaped_.push_back('\r');
+            break;
+          case 't':
+            unescaped_.push_back('\t');
+            break;
+          case 'v':
+            unescaped_.push_back('\v');
+            break;
+          default:
+            unescaped_.push_back(field[i]);
+            break;
+        }
+      }
+      _batch->push_back(unescaped_);
+    }
+
+    ++num_fields;
+
+    if (pos == std::string_view::npos) {
+      break;
+    }
+    _msg.remove_prefix(pos + 1);
+  }
+
+  if (num_fields != oids_.size()) {
+    return error("Expected " + std::to_string(oids_.size()) +
+                 " fields, got " + std::to_string(num_fields) + ".");
+  }
+
+  return Nothing{};
+}
+
+Result<Nothing> CopyIterator::send() noexcept {
+  sent_ = true;
+
+  // While the COPY is running, the transaction status is always active, so
+  // it has to be checked before sending.
+  in_transaction_ = PQtransactionStatus(conn_.get()) != PQTRANS_IDLE;
+
+  if (binary_) {
+    for (size_t j = 0; j < oids_.size(); ++j) {
+      const bool is_enum = j < is_enum_.size() && is_enum_[j];
+      if (!binary::is_decodable(oids_[j]) && !is_enum) {
+        binary_ = false;
+      }
+    }
+  }
+
+  const auto sql = "COPY (" + sql_ + ") TO STDOUT" +
+                   std::string(binary_ ? " WITH (FORMAT binary);" : ";");
+
+  const auto res = PQexec(conn_.get(), sql.c_str());
+  const auto status = PQresultStatus(res);
+  const auto msg = std::string(PQresultErrorMessage(res));
+  PQclear(res);
+
+  if (status != PGRES_COPY_OUT) {
+    received_all_ = true;
+    return error(msg);
+  }
+
+  return Nothing{};
+}
+
+void CopyIterator::set_column_types(const std::vector<dynamic::Type>& _types) {
+  is_enum_.clear();
+  for (const auto& type : _types) {
+    is_enum_.push_back(type.visit([](const auto& _t) {
+      using T = std::remove_cvref_t<decltype(_t)>;
+      return std::is_same_v<T, dynamic::types::Enum>;
+    }));
+  }
+}
+
+void CopyIterator::shutdown() noexcept {
+  end_ = true;
+  if (!sent_ || received_all_) {
+    return;
+  }
+  // Cancelling the COPY would abort the enclosing transaction, so we have to
+  // receive the remaining rows instead.
+  if (!in_transaction_) {
+    const auto cancel = PQgetCancel(conn_.get());
+    if (cancel) {
+      char errbuf[256];
+      PQcancel(cancel, errbuf, sizeof(errbuf));
+      PQfreeCancel(cancel);
+    }
+  }
+  // The rest of the data has to be read, before the connection can be used
+  // again.
+  while (true) {
+    char* buf = nullptr;
+    const int len = PQgetCopyData(conn_.get(), &buf, 0);
+    if (buf) {
+      PQfreemem(buf);
+    }
+    if (len < 0) {
+      break;
+    }
+  }
+  finish();
+}
+
+}  // namespace sqlgen::postgres
@@ -0,0 +1,110 @@
+#include "sqlgen/postgres/EventLoop.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
+#include <cerrno>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sqlgen::postgres {
+
+EventLoop::~EventLoop() {
+  // The tasks must be destroyed while the loop still exists, because they
+  // might be suspended, waiting for it.
+  tasks_.clear();
+}
+
+bool EventLoop::add(Awaiter* _awaiter) noexcept {
+  if (_awaiter->fd_ < 0) {
+    _awaiter->err_ = "Could not watch socket: Invalid socket.";
+    return false;
+  }
+  try {
+    waiting_.push_back(_awaiter);
+  } catch (std::exception& e) {
+    _awaiter->err_ = std::string("Could not watch socket: ") + e.what();
+    return false;
+  }
+  return true;
+}
+
+void EventLoop::run() {
+  while (!waiting_.empty()) {
+    run_once();
+  }
+  const auto tasks = std::exchange(tasks_, {});
+  for (const auto& t : tasks) {
+    if (const auto exception = t.exception(t.task.get())) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+void EventLoop::run_once() {
+  if (waiting_.empty()) {
+    throw std::runtime_error(
+        "The task has not finished, but is not waiting for any socket.");
+  }
+
+  std::vector<pollfd> fds;
+  for (const auto awaiter : waiting_) {
+    pollfd fd{};
+    fd.fd = awaiter->fd_;
+    switch (awaiter->interest_) {
+      case Interest::read:
+        fd.events = POLLIN;
+        break;
+
+      case Interest::write:
+        fd.events = POLLOUT;
+        break;
+
+      case Interest::read_or_write:
+        fd.events = POLLIN | POLLOUT;
+        break;
+    }
+    fds.push_back(fd);
+  }
+
+#ifdef _WIN32
+  const int n = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), -1);
+#else
+  const int n = poll(fds.data(), static_cast<nfds_t>(fds.size()), -1);
+#endif
+
+  if (n < 0) {
+#ifndef _WIN32
+    if (errno == EINTR) {
+      return;
+    }
+#endif
+    throw std::runtime_error("Waiting for the sockets failed.");
+  }
+
+  // All ready coroutines are removed before any of them is resumed,
+  // because they might wait for their sockets again right away. Errors and
+  // hangups count as ready, so that libpq can report them.
+  std::vector<std::coroutine_handle<>> ready;
+  std::vector<Awaiter*> still_waiting;
+  for (size_t i = 0; i < fds.size(); ++i) {
+    if (fds[i].revents != 0) {
+      ready.push_back(waiting_[i]->handle_);
+    } else {
+      still_waiting.push_back(waiting_[i]);
+    }
+  }
+  waiting_ = std::move(still_waiting);
+
+  for (const auto& handle : ready) {
+    handle.resume();
+  }
+}
+
+}  // namespace sqlgen::postgres
@@ -3,69 +3,100 @@
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
+#include <type_traits>
 
 #include "sqlgen/internal/collect/vector.hpp"
 #include "sqlgen/internal/strings/strings.hpp"
+#include "sqlgen/postgres/binary.hpp"
 #include "sqlgen/postgres/exec.hpp"
+#include "sqlgen/postgres/push_rows.hpp"
 
 namespace sqlgen::postgres {
 
-Iterator::Iterator(const std::string& _sql, const ConnPtr& _conn)
-    : cursor_name_(make_cursor_name()), conn_(_conn), end_(false) {
+Iterator::Iterator(const std::string& _sql, const ConnPtr& _conn,
+                   const bool _binary,
+                   const std::vector<std::optional<std::string>>& _params)
+    : cursor_name_(make_cursor_name()),
+      conn_(_conn),
+      end_(false),
+      binary_(_binary),
+      described_(false) {
   exec(conn_, "BEGIN").value();
-  exec(conn_, "DECLARE " + cursor_name_ + " CURSOR FOR " + _sql).value();
+  const auto declare = "DECLARE " + cursor_name_ + " CURSOR FOR " + _sql;
+  if (_params.size() == 0) {
+    exec(conn_, declare).value();
+  } else {
+    exec(conn_, declare, _params).value();
+  }
 }
 
 Iterator::Iterator(Iterator&& _other) noexcept
     : cursor_name_(std::move(_other.cursor_name_)),
       conn_(std::move(_other.conn_)),
-      end_(_other.end_) {
+      end_(_other.end_),
+      binary_(_other.binary_),
+      described_(_other.described_),
+      is_enum_(std::move(_other.is_enum_)),
+      oids_(std::move(_other.oids_)) {
   _other.end_ = true;
 }
 
 Iterator::~Iterator() { shutdown(); }
 
-bool Iterator::end() const { return end_; }
+void Iterator::describe() {
+  described_ = true;
 
-Result<std::vector<std::vector<std::optional<std::string>>>> Iterator::next(
-    const size_t _batch_size) {
-  if (end()) {
-    return error("End is reached.");
+  const auto res = PQdescribePortal(conn_.get(), cursor_name_.c_str());
+
+  if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+    PQclear(res);
+    binary_ = false;
+    return;
   }
 
-  const auto to_vector = [](const Ref<PGresult>& _res)
-      -> std::vector<std::vector<std::optional<std::string>>> {
-    const int num_rows = PQntuples(_res.get());
-    const int num_cols = PQnfields(_res.get());
+  const int num_cols = PQnfields(res);
 
-    std::vector<std::vector<std::optional<std::string>>> vec(num_rows);
+  for (int j = 0; j < num_cols; ++j) {
+    const auto oid = PQftype(res, j);
+    const bool is_enum =
+        static_cast<size_t>(j) < is_enum_.size() && is_enum_[j];
+    if (!binary::is_decodable(oid) && !is_enum) {
+      binary_ = false;
+    }
+    oids_.push_back(oid);
+  }
 
-    for (int i = 0; i < num_rows; ++i) {
-      std::vector<std::optional<std::string>> row(num_cols);
+  PQclear(res);
+}
 
-      for (int j = 0; j < num_cols; ++j) {
-        const bool is_null = PQgetisnull(_res.get(), i, j);
-        if (is_null) {
-          row[j] = std::nullopt;
-        } else {
-          row[j] = std::string(PQgetvalue(_res.get(), i, j));
-        }
-      }
+bool Iterator::end() const { return end_; }
 
-      vec[i] = std::move(row);
-    }
+Result<RowBatch> Iterator::next(const size_t _batch_size) {
+  if (end()) {
+    return error("End is reached.");
+  }
+
+  if (binary_ && !described_) {
+    describe();
+  }
 
-    return vec;
+  const auto to_batch = [this](const Ref<PGresult>& _res) -> RowBatch {
+    const int num_rows = PQntuples(_res.get());
+    RowBatch batch(static_cast<size_t>(PQnfields(_res.get())));
+    batch.reserve(static_cast<size_t>(num_rows));
+    push_rows(_res.get(), 0, num_rows, binary_, oids_, &batch);
+    return batch;
   };
 
   return exec(conn_, "FETCH FORWARD " + std::to_string(_batch_size) + " FROM " +
-                         cursor_name_ + ";")
-      .transform(to_vector)
-      .transform([this](auto&& _vec) {
-        if (_vec.size() == 0) {
+                         cursor_name_ + ";",
+              binary_)
+      .transform(to_batch)
+      .transform([this](auto&& _batch) {
+        if (_batch.size() == 0) {
           shutdown();
         }
-        return std::move(_vec);
+        return std::move(_batch);
       });
 }
 
@@ -77,10 +108,24 @@ Iterator& Iterator::operator=(Iterator&& _other) noexcept {
   cursor_name_ = std::move(_other.cursor_name_);
   conn_ = std::move(_other.conn_);
   end_ = _other.end_;
+  binary_ = _other.binary_;
+  described_ = _other.described_;
+  is_enum_ = std::move(_other.is_enum_);
+  oids_ = std::move(_other.oids_);
   _other.end_ = true;
   return *this;
 }
 
+void Iterator::set_column_types(const std::vector<dynamic::Type>& _types) {
+  is_enum_.clear();
+  for (const auto& type : _types) {
+    is_enum_.push_back(type.visit([](const auto& _t) {
+      using T = std::remove_cvref_t<decltype(_t)>;
+      return std::is_same_v<T, dynamic::types::Enum>;
+    }));
+  }
+}
+
 void Iterator::shutdown() {
   if (!end_) {
     exec(conn_, "CLOSE " + cursor_name_);
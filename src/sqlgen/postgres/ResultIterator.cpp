@@ -0,0 +1,31 @@
+#include "sqlgen/postgres/ResultIterator.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "sqlgen/postgres/push_rows.hpp"
+
+namespace sqlgen::postgres {
+
+ResultIterator::ResultIterator(const Ref<PGresult>& _res)
+    : res_(_res), row_ix_(0) {}
+
+bool ResultIterator::end() const { return row_ix_ >= PQntuples(res_.get()); }
+
+Result<RowBatch> ResultIterator::next(const size_t _batch_size) {
+  if (end()) {
+    return error("End is reached.");
+  }
+
+  const int n = static_cast<int>(std::min<size_t>(
+      static_cast<size_t>(PQntuples(res_.get()) - row_ix_), _batch_size));
+
+  RowBatch batch(static_cast<size_t>(PQnfields(res_.get())));
+  push_rows(res_.get(), row_ix_, row_ix_ + n, false, std::vector<Oid>(),
+            &batch);
+  row_ix_ += n;
+
+  return batch;
+}
+
+}  // namespace sqlgen::postgres
@@ -0,0 +1,260 @@
+#include "sqlgen/postgres/StreamingIterator.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "sqlgen/postgres/binary.hpp"
+#include "sqlgen/postgres/push_rows.hpp"
+
+namespace sqlgen::postgres {
+
+StreamingIterator::StreamingIterator(const std::string& _sql,
+                                     const ConnPtr& _conn, const bool _binary)
+    : conn_(_conn),
+      current_(nullptr, &PQclear),
+      end_(false),
+      binary_(_binary),
+      in_transaction_(false),
+      received_all_(false),
+      row_ix_(0),
+      sent_(false) {
+  if (binary_) {
+    // We need to know the column types before we can decide on the result
+    // format, so the statement is prepared and described first. This also
+    // means that errors in the query are reported right away.
+    const auto prepared = ResultPtr(
+        PQprepare(conn_.get(), "", _sql.c_str(), 0, nullptr), &PQclear);
+    if (PQresultStatus(prepared.get()) != PGRES_COMMAND_OK) {
+      throw std::runtime_error(PQresultErrorMessage(prepared.get()));
+    }
+    describe();
+    return;
+  }
+
+  sql_ = _sql;
+
+  const auto res = send().and_then([this](const auto&) { return receive(); });
+  if (!res) {
+    end_ = true;
+    throw std::runtime_error(res.error().what());
+  }
+}
+
+StreamingIterator::StreamingIterator(
+    const std::string& _stmt_name,
+    const std::vector<std::optional<std::string>>& _params,
+    const ConnPtr& _conn, const bool _binary)
+    : conn_(_conn),
+      current_(nullptr, &PQclear),
+      end_(false),
+      binary_(_binary),
+      in_transaction_(false),
+      received_all_(false),
+      row_ix_(0),
+      sent_(false),
+      params_(_params),
+      stmt_name_(_stmt_name) {
+  if (binary_) {
+    describe();
+    return;
+  }
+
+  const auto res = send().and_then([this](const auto&) { return receive(); });
+  if (!res) {
+    end_ = true;
+    throw std::runtime_error(res.error().what());
+  }
+}
+
+StreamingIterator::~StreamingIterator() { shutdown(); }
+
+void StreamingIterator::describe() {
+  const auto described =
+      ResultPtr(PQdescribePrepared(conn_.get(), stmt_name_.c_str()), &PQclear);
+  if (PQresultStatus(described.get()) != PGRES_COMMAND_OK) {
+    throw std::runtime_error(PQresultErrorMessage(described.get()));
+  }
+
+  const int num_cols = PQnfields(described.get());
+  for (int j = 0; j < num_cols; ++j) {
+    oids_.push_back(PQftype(described.get(), j));
+  }
+}
+
+void StreamingIterator::drain() noexcept {
+  while (true) {
+    const auto res = PQgetResult(conn_.get());
+    if (!res) {
+      break;
+    }
+    PQclear(res);
+  }
+  received_all_ = true;
+}
+
+bool StreamingIterator::end() const { return end_; }
+
+Result<RowBatch> StreamingIterator::next(const size_t _batch_size) {
+  if (end()) {
+    return error("End is reached.");
+  }
+
+  if (!sent_) {
+    const auto res =
+        send().and_then([this](const auto&) { return receive(); });
+    if (!res) {
+      end_ = true;
+      return error(res.error().what());
+    }
+  }
+
+  std::optional<RowBatch> batch;
+
+  while (true) {
+    const int num_rows = current_ ? PQntuples(current_.get()) : 0;
+
+    if (current_ && !batch) {
+      batch.emplace(static_cast<size_t>(PQnfields(current_.get())));
+    }
+
+    if (row_ix_ < num_rows) {
+      const auto remaining = _batch_size - batch->size();
+      const int n = static_cast<int>(std::min<size_t>(
+          static_cast<size_t>(num_rows - row_ix_), remaining));
+      push_rows(current_.get(), row_ix_, row_ix_ + n, binary_, oids_,
+                &*batch);
+      row_ix_ += n;
+    }
+
+    if (row_ix_ >= num_rows && received_all_) {
+      end_ = true;
+      break;
+    }
+
+    if (batch && batch->size() >= _batch_size) {
+      break;
+    }
+
+    if (row_ix_ >= num_rows) {
+      const auto res = receive();
+      if (!res) {
+        end_ = true;
+        return error(res.error().what());
+      }
+    }
+  }
+
+  return batch ? std::move(*batch) : RowBatch();
+}
+
+Result<Nothing> StreamingIterator::receive() noexcept {
+  current_.reset(PQgetResult(conn_.get()));
+  row_ix_ = 0;
+
+  if (!current_) {
+    received_all_ = true;
+    return Nothing{};
+  }
+
+  switch (PQresultStatus(current_.get())) {
+    case PGRES_SINGLE_TUPLE:
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    case PGRES_TUPLES_CHUNK:
+#endif
+      return Nothing{};
+
+    case PGRES_TUPLES_OK:
+      // This is the final result. In single row or chunked mode, it holds
+      // no rows, but if we could not switch modes, it holds all of them.
+      drain();
+      return Nothing{};
+
+    default: {
+      const auto msg = std::string(PQresultErrorMessage(current_.get()));
+      current_.reset();
+      drain();
+      return error(msg);
+    }
+  }
+}
+
+Result<Nothing> StreamingIterator::send() noexcept {
+  sent_ = true;
+
+  // While the query is running, the transaction status is always active,
+  // so it has to be checked before sending.
+  in_transaction_ = PQtransactionStatus(conn_.get()) != PQTRANS_IDLE;
+
+  if (binary_) {
+    for (size_t j = 0; j < oids_.size(); ++j) {
+      const bool is_enum = j < is_enum_.size() && is_enum_[j];
+      if (!binary::is_decodable(oids_[j]) && !is_enum) {
+        binary_ = false;
+      }
+    }
+  }
+
+  std::vector<const char*> values;
+  for (const auto& param : params_) {
+    values.push_back(param ? param->c_str() : nullptr);
+  }
+
+  const int ok =
+      sql_.empty()
+          ? PQsendQueryPrepared(conn_.get(), stmt_name_.c_str(),
+                                static_cast<int>(values.size()),
+                                values.data(), nullptr, nullptr,
+                                binary_ ? 1 : 0)
+          : PQsendQueryParams(conn_.get(), sql_.c_str(), 0, nullptr, nullptr,
+                              nullptr, nullptr, 0);
+  if (!ok) {
+    received_all_ = true;
+    return error(PQerrorMessage(conn_.get()));
+  }
+
+  // If this fails, all rows arrive in a single result, which we can handle
+  // as well.
+#ifdef LIBPQ_HAS_CHUNK_MODE
+  PQsetChunkedRowsMode(conn_.get(), chunk_size_);
+#else
+  PQsetSingleRowMode(conn_.get());
+#endif
+
+  return Nothing{};
+}
+
+void StreamingIterator::set_column_types(
+    const std::vector<dynamic::Type>& _types) {
+  is_enum_.clear();
+  for (const auto& type : _types) {
+    is_enum_.push_back(type.visit([](const auto& _t) {
+      using T = std::remove_cvref_t<decltype(_t)>;
+      return std::is_same_v<T, dynamic::types::Enum>;
+    }));
+  }
+}
+
+void StreamingIterator::shutdown() noexcept {
+  end_ = true;
+  if (!sent_ || received_all_) {
+    return;
+  }
+  // Cancelling the query would abort the enclosing transaction, so we have
+  // to receive the remaining rows instead.
+  if (!in_transaction_) {
+    const auto cancel = PQgetCancel(conn_.get());
+    if (cancel) {
+      char errbuf[256];
+      PQcancel(cancel, errbuf, sizeof(errbuf));
+      PQfreeCancel(cancel);
+    }
+  }
+  current_.reset();
+  drain();
+}
+
+}  // namespace sqlgen::postgres
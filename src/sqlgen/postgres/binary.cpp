@@ -0,0 +1,544 @@
+#include "sqlgen/postgres/binary.hpp"
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include "sqlgen/internal/native_to_text.hpp"
+#include "sqlgen/internal/parse_timestamp.hpp"
+
+namespace sqlgen::postgres::binary {
+
+/// The OIDs of the builtin types, as defined in pg_type.dat.
+enum class OID : Oid {
+  bool_ = 16,
+  bytea = 17,
+  char_ = 18,
+  name = 19,
+  int8 = 20,
+  int2 = 21,
+  int4 = 23,
+  text = 25,
+  oid = 26,
+  json = 114,
+  float4 = 700,
+  float8 = 701,
+  bpchar = 1042,
+  varchar = 1043,
+  date = 1082,
+  timestamp = 1114,
+  timestamptz = 1184,
+  uuid = 2950,
+  jsonb = 3802
+};
+
+/// The number of microseconds between the Unix epoch and the postgres epoch
+/// (2000-01-01).
+constexpr std::int64_t postgres_epoch_in_microseconds = 946684800000000;
+
+/// The number of microseconds in a day.
+constexpr std::int64_t microseconds_per_day = 86400000000;
+
+/// Values are sent in network byte order (big endian).
+std::uint64_t read_uint(const char* _ptr, const size_t _len) noexcept {
+  std::uint64_t val = 0;
+  for (size_t i = 0; i < _len; ++i) {
+    val = (val << 8) | static_cast<unsigned char>(_ptr[i]);
+  }
+  return val;
+}
+
+/// Appends _val to _buffer in network byte order.
+void write_uint(const std::uint64_t _val, const size_t _len,
+                std::string* _buffer) {
+  for (size_t i = _len; i > 0; --i) {
+    _buffer->push_back(static_cast<char>((_val >> (8 * (i - 1))) & 0xff));
+  }
+}
+
+template <class T>
+T read_as(const char* _ptr) noexcept {
+  using UIntType =
+      std::conditional_t<sizeof(T) == 8, std::uint64_t,
+                         std::conditional_t<sizeof(T) == 4, std::uint32_t,
+                                            std::uint16_t>>;
+  const auto bits = static_cast<UIntType>(read_uint(_ptr, sizeof(T)));
+  T val;
+  std::memcpy(&val, &bits, sizeof(T));
+  return val;
+}
+
+bool is_decodable(const Oid _oid) noexcept {
+  switch (static_cast<OID>(_oid)) {
+    case OID::bool_:
+    case OID::bytea:
+    case OID::char_:
+    case OID::name:
+    case OID::int8:
+    case OID::int2:
+    case OID::int4:
+    case OID::text:
+    case OID::oid:
+    case OID::json:
+    case OID::float4:
+    case OID::float8:
+    case OID::bpchar:
+    case OID::varchar:
+    case OID::date:
+    case OID::timestamp:
+    case OID::timestamptz:
+    case OID::uuid:
+    case OID::jsonb:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+void push_back(const Oid _oid, const char* _ptr, const size_t _len,
+               RowBatch* _batch) {
+  switch (static_cast<OID>(_oid)) {
+    case OID::bool_:
+      _batch->push_int64(_len > 0 && _ptr[0] != 0 ? 1 : 0);
+      return;
+
+    case OID::int2:
+      _batch->push_int64(read_as<std::int16_t>(_ptr));
+      return;
+
+    case OID::int4:
+      _batch->push_int64(read_as<std::int32_t>(_ptr));
+      return;
+
+    case OID::int8:
+      _batch->push_int64(read_as<std::int64_t>(_ptr));
+      return;
+
+    case OID::oid:
+      _batch->push_int64(read_as<std::uint32_t>(_ptr));
+      return;
+
+    case OID::float4:
+      _batch->push_float64(read_as<float>(_ptr));
+      return;
+
+    case OID::float8:
+      _batch->push_float64(read_as<double>(_ptr));
+      return;
+
+    case OID::date: {
+      const auto days = read_as<std::int32_t>(_ptr);
+      if (days == std::numeric_limits<std::int32_t>::max()) {
+        _batch->push_back("infinity");
+      } else if (days == std::numeric_limits<std::int32_t>::min()) {
+        _batch->push_back("-infinity");
+      } else {
+        _batch->push_timestamp(days * microseconds_per_day +
+                               postgres_epoch_in_microseconds);
+      }
+      return;
+    }
+
+    case OID::timestamp:
+    case OID::timestamptz: {
+      const auto microseconds = read_as<std::int64_t>(_ptr);
+      if (microseconds == std::numeric_limits<std::int64_t>::max()) {
+        _batch->push_back("infinity");
+      } else if (microseconds == std::numeric_limits<std::int64_t>::min()) {
+        _batch->push_back("-infinity");
+      } else {
+        _batch->push_timestamp(microseconds + postgres_epoch_in_microseconds);
+      }
+      return;
+    }
+
+    case OID::uuid: {
+      constexpr auto hex = "0123456789abcdef";
+      std::array<char, 36> buf{};
+      size_t k = 0;
+      for (size_t i = 0; i < 16 && i < _len; ++i) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+          buf[k++] = '-';
+        }
+        const auto byte = static_cast<unsigned char>(_ptr[i]);
+        buf[k++] = hex[byte >> 4];
+        buf[k++] = hex[byte & 0x0f];
+      }
+      _batch->push_back(std::string_view(buf.data(), k));
+      return;
+    }
+
+    case OID::jsonb:
+      // The first byte is the version number of the jsonb format.
+      _batch->push_back(_len > 0 ? std::string_view(_ptr + 1, _len - 1)
+                                 : std::string_view());
+      return;
+
+    default:
+      // bytea, text and other character types are sent as raw bytes.
+      _batch->push_back(std::string_view(_ptr, _len));
+      return;
+  }
+}
+
+template <class T>
+void write_as(const T _val, std::string* _buffer) {
+  using UIntType =
+      std::conditional_t<sizeof(T) == 8, std::uint64_t,
+                         std::conditional_t<sizeof(T) == 4, std::uint32_t,
+                                            std::uint16_t>>;
+  UIntType bits;
+  std::memcpy(&bits, &_val, sizeof(T));
+  write_uint(bits, sizeof(T), _buffer);
+}
+
+/// Appends a value of type T, prefixed by its length.
+template <class T>
+void write_field(const T _val, std::string* _buffer) {
+  write_as<std::int32_t>(static_cast<std::int32_t>(sizeof(T)), _buffer);
+  write_as<T>(_val, _buffer);
+}
+
+/// Appends raw bytes, prefixed by their length.
+void write_field(const std::string_view _val, std::string* _buffer) {
+  write_as<std::int32_t>(static_cast<std::int32_t>(_val.size()), _buffer);
+  _buffer->append(_val);
+}
+
+std::optional<std::int64_t> to_int64(const RowBatch::Cell& _cell) noexcept {
+  if (_cell.kind() == RowBatch::Cell::Kind::int64) {
+    return _cell.int64();
+  }
+  if (_cell.kind() != RowBatch::Cell::Kind::text) {
+    return std::nullopt;
+  }
+  const auto str = _cell.text();
+  std::int64_t val = 0;
+  const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(),
+                                         val);
+  if (ec != std::errc() || ptr != str.data() + str.size()) {
+    return std::nullopt;
+  }
+  return val;
+}
+
+std::optional<double> to_float64(const RowBatch::Cell& _cell) noexcept {
+  switch (_cell.kind()) {
+    case RowBatch::Cell::Kind::float64:
+      return _cell.float64();
+
+    case RowBatch::Cell::Kind::int64:
+      return static_cast<double>(_cell.int64());
+
+    case RowBatch::Cell::Kind::text: {
+      const auto str = _cell.text();
+      double val = 0.0;
+      const auto [ptr, ec] =
+          std::from_chars(str.data(), str.data() + str.size(), val);
+      if (ec != std::errc() || ptr != str.data() + str.size()) {
+        return std::nullopt;
+      }
+      return val;
+    }
+
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<bool> to_bool(const RowBatch::Cell& _cell) noexcept {
+  if (_cell.kind() == RowBatch::Cell::Kind::int64) {
+    return _cell.int64() != 0;
+  }
+  if (_cell.kind() != RowBatch::Cell::Kind::text) {
+    return std::nullopt;
+  }
+  const auto str = _cell.text();
+  if (str == "t" || str == "true" || str == "TRUE" || str == "1") {
+    return true;
+  }
+  if (str == "f" || str == "false" || str == "FALSE" || str == "0") {
+    return false;
+  }
+  return std::nullopt;
+}
+
+/// Parses 'YYYY-MM-DD' or 'YYYY-MM-DD HH:MM:SS[.ffffff][Z|+HH[[:]MM]]' into
+/// microseconds since the Unix epoch. The offset is only applied if
+/// _apply_offset is true, because postgres ignores it for columns of type
+/// TIMESTAMP.
+std::optional<std::int64_t> parse_microseconds(
+    const std::string_view _str, const bool _apply_offset) noexcept {
+  using Value = internal::TimestampLayout::Value;
+
+  const bool has_time = _str.size() > 10;
+
+  const auto tm = internal::parse_timestamp(
+      _str.substr(0, has_time ? 19 : 10),
+      internal::TimestampLayout{
+          .value = has_time ? Value::date_time : Value::date,
+          .separator = has_time ? _str[10] : ' '});
+
+  if (!tm) {
+    return std::nullopt;
+  }
+
+  using namespace std::chrono;
+
+  const auto ymd = year_month_day(
+      year(tm->tm_year + 1900), month(static_cast<unsigned>(tm->tm_mon + 1)),
+      day(static_cast<unsigned>(tm->tm_mday)));
+
+  std::int64_t seconds =
+      static_cast<std::int64_t>(sys_days(ymd).time_since_epoch().count()) *
+          86400 +
+      tm->tm_hour * 3600 + tm->tm_min * 60 + tm->tm_sec;
+
+  std::int64_t fraction = 0;
+
+  auto rest = _str.substr(has_time ? 19 : 10);
+
+  const auto is_digit = [](const char _c) {
+    return static_cast<unsigned>(_c - '0') <= 9;
+  };
+
+  if (!rest.empty() && rest[0] == '.') {
+    rest.remove_prefix(1);
+    std::int64_t scale = 100000;
+    while (!rest.empty() && is_digit(rest[0])) {
+      if (scale > 0) {
+        fraction += (rest[0] - '0') * scale;
+        scale /= 10;
+      }
+      rest.remove_prefix(1);
+    }
+  }
+
+  if (rest == "Z") {
+    rest.remove_prefix(1);
+  } else if (!rest.empty() && (rest[0] == '+' || rest[0] == '-')) {
+    const bool negative = rest[0] == '-';
+    rest.remove_prefix(1);
+    std::int64_t offset = 0;
+    for (const auto unit : {3600, 60}) {
+      if (!rest.empty() && rest[0] == ':' && unit == 60) {
+        rest.remove_prefix(1);
+      }
+      if (rest.size() < 2 || !is_digit(rest[0]) || !is_digit(rest[1])) {
+        if (unit == 3600) {
+          return std::nullopt;
+        }
+        break;
+      }
+      offset += ((rest[0] - '0') * 10 + (rest[1] - '0')) * unit;
+      rest.remove_prefix(2);
+    }
+    if (_apply_offset) {
+      seconds -= negative ? -offset : offset;
+    }
+  }
+
+  if (!rest.empty()) {
+    return std::nullopt;
+  }
+
+  return seconds * 1000000 + fraction;
+}
+
+/// Returns the number of microseconds since the Unix epoch, or the largest
+/// or smallest value for 'infinity' and '-infinity'.
+std::optional<std::int64_t> to_microseconds(
+    const RowBatch::Cell& _cell, const bool _apply_offset) noexcept {
+  if (_cell.kind() == RowBatch::Cell::Kind::timestamp) {
+    return _cell.timestamp();
+  }
+  if (_cell.kind() != RowBatch::Cell::Kind::text) {
+    return std::nullopt;
+  }
+  const auto str = _cell.text();
+  if (str == "infinity") {
+    return std::numeric_limits<std::int64_t>::max();
+  }
+  if (str == "-infinity") {
+    return std::numeric_limits<std::int64_t>::min();
+  }
+  return parse_microseconds(str, _apply_offset);
+}
+
+bool is_encodable(const Oid _oid) noexcept {
+  switch (static_cast<OID>(_oid)) {
+    case OID::bool_:
+    case OID::name:
+    case OID::int8:
+    case OID::int2:
+    case OID::int4:
+    case OID::text:
+    case OID::json:
+    case OID::float4:
+    case OID::float8:
+    case OID::bpchar:
+    case OID::varchar:
+    case OID::date:
+    case OID::timestamp:
+    case OID::timestamptz:
+    case OID::jsonb:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+Result<Nothing> append(const Oid _oid, const RowBatch::Cell& _cell,
+                       std::string* _buffer) noexcept {
+  if (_cell.is_null()) {
+    write_as<std::int32_t>(-1, _buffer);
+    return Nothing{};
+  }
+
+  const auto cannot_encode = [&]() -> Result<Nothing> {
+    std::array<char, 32> buf{};
+    const auto str = internal::native_to_text(_cell, &buf);
+    return error("Could not encode '" +
+                 std::string(str ? *str : std::string_view()) +
+                 "' as a value of the type with OID " + std::to_string(_oid) +
+                 ".");
+  };
+
+  const auto in_range = [](const std::int64_t _val, auto _t) {
+    using T = decltype(_t);
+    return _val >= std::numeric_limits<T>::min() &&
+           _val <= std::numeric_limits<T>::max();
+  };
+
+  switch (static_cast<OID>(_oid)) {
+    case OID::bool_: {
+      const auto val = to_bool(_cell);
+      if (!val) {
+        return cannot_encode();
+      }
+      write_field<std::int8_t>(*val ? 1 : 0, _buffer);
+      return Nothing{};
+    }
+
+    case OID::int2: {
+      const auto val = to_int64(_cell);
+      if (!val || !in_range(*val, std::int16_t())) {
+        return cannot_encode();
+      }
+      write_field<std::int16_t>(static_cast<std::int16_t>(*val), _buffer);
+      return Nothing{};
+    }
+
+    case OID::int4: {
+      const auto val = to_int64(_cell);
+      if (!val || !in_range(*val, std::int32_t())) {
+        return cannot_encode();
+      }
+      write_field<std::int32_t>(static_cast<std::int32_t>(*val), _buffer);
+      return Nothing{};
+    }
+
+    case OID::int8: {
+      const auto val = to_int64(_cell);
+      if (!val) {
+        return cannot_encode();
+      }
+      write_field<std::int64_t>(*val, _buffer);
+      return Nothing{};
+    }
+
+    case OID::float4: {
+      const auto val = to_float64(_cell);
+      if (!val) {
+        return cannot_encode();
+      }
+      write_field<float>(static_cast<float>(*val), _buffer);
+      return Nothing{};
+    }
+
+    case OID::float8: {
+      const auto val = to_float64(_cell);
+      if (!val) {
+        return cannot_encode();
+      }
+      write_field<double>(*val, _buffer);
+      return Nothing{};
+    }
+
+    case OID::date: {
+      const auto val = to_microseconds(_cell, false);
+      if (!val) {
+        return cannot_encode();
+      }
+      if (*val == std::numeric_limits<std::int64_t>::max() ||
+          *val == std::numeric_limits<std::int64_t>::min()) {
+        write_field<std::int32_t>(
+            *val > 0 ? std::numeric_limits<std::int32_t>::max()
+                     : std::numeric_limits<std::int32_t>::min(),
+            _buffer);
+        return Nothing{};
+      }
+      // Rounds towards negative infinity, so times of day are dropped.
+      const auto us = *val - postgres_epoch_in_microseconds;
+      const auto days = us / microseconds_per_day -
+                        (us % microseconds_per_day < 0 ? 1 : 0);
+      if (!in_range(days, std::int32_t())) {
+        return cannot_encode();
+      }
+      write_field<std::int32_t>(static_cast<std::int32_t>(days), _buffer);
+      return Nothing{};
+    }
+
+    case OID::timestamp:
+    case OID::timestamptz: {
+      const auto val =
+          to_microseconds(_cell, static_cast<OID>(_oid) == OID::timestamptz);
+      if (!val) {
+        return cannot_encode();
+      }
+      if (*val == std::numeric_limits<std::int64_t>::max() ||
+          *val == std::numeric_limits<std::int64_t>::min()) {
+        write_field<std::int64_t>(*val, _buffer);
+      } else {
+        write_field<std::int64_t>(*val - postgres_epoch_in_microseconds,
+                                  _buffer);
+      }
+      return Nothing{};
+    }
+
+    case OID::jsonb: {
+      std::array<char, 32> buf{};
+      const auto str = internal::native_to_text(_cell, &buf);
+      if (!str) {
+        return cannot_encode();
+      }
+      // The first byte is the version number of the jsonb format.
+      write_as<std::int32_t>(static_cast<std::int32_t>(str->size() + 1),
+                             _buffer);
+      _buffer->push_back(1);
+      _buffer->append(*str);
+      return Nothing{};
+    }
+
+    default: {
+      // Text and other character types are sent as raw bytes.
+      std::array<char, 32> buf{};
+      const auto str = internal::native_to_text(_cell, &buf);
+      if (!str) {
+        return cannot_encode();
+      }
+      write_field(*str, _buffer);
+      return Nothing{};
+    }
+  }
+}
+
+}  // namespace sqlgen::postgres::binary
@@ -4,24 +4,82 @@
 #include <rfl.hpp>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 namespace sqlgen::postgres {
 
-Result<Ref<PGresult>> exec(const Ref<PGconn>& _conn,
-                           const std::string& _sql) noexcept {
-  const auto res = PQexec(_conn.get(), _sql.c_str());
+Result<Ref<PGresult>> exec(const Ref<PGconn>& _conn, const std::string& _sql,
+                           const bool _binary) noexcept {
+  const auto res = _binary ? PQexecParams(_conn.get(),  // conn
+                                          _sql.c_str(),  // command
+                                          0,             // nParams
+                                          nullptr,       // paramTypes
+                                          nullptr,       // paramValues
+                                          nullptr,       // paramLengths
+                                          nullptr,       // paramFormats
+                                          1              // resultFormat
+                                          )
+                           : PQexec(_conn.get(), _sql.c_str());
 
-  const auto status = PQresultStatus(res);
+  return wrap_result(res, _sql);
+}
+
+Result<Ref<PGresult>> exec(
+    const Ref<PGconn>& _conn, const std::string& _sql,
+    const std::vector<std::optional<std::string>>& _params) noexcept {
+  std::vector<const char*> values;
+  for (const auto& param : _params) {
+    values.push_back(param ? param->c_str() : nullptr);
+  }
+
+  const auto res =
+      PQexecParams(_conn.get(),                      // conn
+                   _sql.c_str(),                     // command
+                   static_cast<int>(values.size()),  // nParams
+                   nullptr,                          // paramTypes
+                   values.data(),                    // paramValues
+                   nullptr,                          // paramLengths
+                   nullptr,                          // paramFormats
+                   0                                 // resultFormat
+      );
+
+  return wrap_result(res, _sql);
+}
+
+Result<Ref<PGresult>> exec_prepared(
+    const Ref<PGconn>& _conn, const std::string& _stmt_name,
+    const std::vector<std::optional<std::string>>& _params) noexcept {
+  std::vector<const char*> values;
+  for (const auto& param : _params) {
+    values.push_back(param ? param->c_str() : nullptr);
+  }
+
+  const auto res =
+      PQexecPrepared(_conn.get(),                      // conn
+                     _stmt_name.c_str(),               // stmtName
+                     static_cast<int>(values.size()),  // nParams
+                     values.data(),                    // paramValues
+                     nullptr,                          // paramLengths
+                     nullptr,                          // paramFormats
+                     0                                 // resultFormat
+      );
+
+  return wrap_result(res, _stmt_name);
+}
+
+Result<Ref<PGresult>> wrap_result(PGresult* _res,
+                                  const std::string& _sql) noexcept {
+  const auto status = PQresultStatus(_res);
 
   if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK &&
       status != PGRES_COPY_IN) {
-    const auto err =
-        error("Executing '" + _sql + "' failed: " + PQresultErrorMessage(res));
-    PQclear(res);
+    const auto err = error("Executing '" + _sql +
+                           "' failed: " + PQresultErrorMessage(_res));
+    PQclear(_res);
     return err;
   }
 
-  return Ref<PGresult>::make(std::shared_ptr<PGresult>(res, PQclear));
+  return Ref<PGresult>::make(std::shared_ptr<PGresult>(_res, PQclear));
 }
 
 }  // namespace sqlgen::postgres
@@ -0,0 +1,30 @@
+#include "sqlgen/postgres/push_rows.hpp"
+
+#include <string_view>
+
+#include "sqlgen/postgres/binary.hpp"
+
+namespace sqlgen::postgres {
+
+void push_rows(const PGresult* _res, const int _begin, const int _end,
+               const bool _binary, const std::vector<Oid>& _oids,
+               RowBatch* _batch) {
+  const int num_cols = PQnfields(_res);
+  for (int i = _begin; i < _end; ++i) {
+    for (int j = 0; j < num_cols; ++j) {
+      if (PQgetisnull(_res, i, j)) {
+        _batch->push_null();
+      } else if (_binary) {
+        binary::push_back(_oids[j], PQgetvalue(_res, i, j),
+                          static_cast<size_t>(PQgetlength(_res, i, j)),
+                          _batch);
+      } else {
+        _batch->push_back(
+            std::string_view(PQgetvalue(_res, i, j),
+                             static_cast<size_t>(PQgetlength(_res, i, j))));
+      }
+    }
+  }
+}
+
+}  // namespace sqlgen::postgres
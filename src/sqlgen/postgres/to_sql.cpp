@@ -1,5 +1,6 @@
 #include "sqlgen/postgres/to_sql.hpp"
 
+#include <algorithm>
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
@@ -125,7 +126,10 @@ std::string column_or_value_to_sql(
     const dynamic::ColumnOrValue& _col) noexcept {
   const auto handle_value = [](const auto& _v) -> std::string {
     using Type = std::remove_cvref_t<decltype(_v)>;
-    if constexpr (std::is_same_v<Type, dynamic::String>) {
+    if constexpr (std::is_same_v<Type, dynamic::Param>) {
+      return "$" + std::to_string(_v.ix);
+
+    } else if constexpr (std::is_same_v<Type, dynamic::String>) {
       return "'" + escape_single_quote(_v.val) + "'";
 
     } else if constexpr (std::is_same_v<Type, dynamic::Duration>) {
@@ -457,12 +461,21 @@ std::string insert_to_sql(const dynamic::Insert& _stmt) noexcept {
       internal::collect::vector(_stmt.columns | transform(wrap_in_quotes)));
   stream << ")";
 
-  stream << " VALUES (";
-  stream << internal::strings::join(
-      ", ", internal::collect::vector(
-                iota(static_cast<size_t>(0), _stmt.columns.size()) |
-                transform(to_placeholder)));
-  stream << ")";
+  const auto num_cols = _stmt.columns.size();
+  const auto num_rows = std::max<size_t>(_stmt.num_rows, 1);
+
+  stream << " VALUES ";
+  for (size_t i = 0; i < num_rows; ++i) {
+    if (i != 0) {
+      stream << ", ";
+    }
+    stream << "(";
+    stream << internal::strings::join(
+        ", ",
+        internal::collect::vector(iota(i * num_cols, (i + 1) * num_cols) |
+                                  transform(to_placeholder)));
+    stream << ")";
+  }
 
   if (_stmt.or_replace) {
     stream << " ON CONFLICT (";
@@ -873,4 +886,25 @@ std::string write_to_sql(const dynamic::Write& _stmt) noexcept {
          ") FROM STDIN WITH DELIMITER '\t' NULL '\e' CSV QUOTE '\a';";
 }
 
+std::string write_binary_to_sql(const dynamic::Write& _stmt) noexcept {
+  using namespace std::ranges::views;
+  const auto schema = wrap_in_quotes(_stmt.table.schema.value_or("public"));
+  const auto table = wrap_in_quotes(_stmt.table.name);
+  const auto colnames = internal::strings::join(
+      ", ",
+      internal::collect::vector(_stmt.columns | transform(wrap_in_quotes)));
+  return "COPY " + schema + "." + table + "(" + colnames +
+         ") FROM STDIN WITH (FORMAT binary);";
+}
+
+std::string write_types_to_sql(const dynamic::Write& _stmt) noexcept {
+  using namespace std::ranges::views;
+  const auto schema = wrap_in_quotes(_stmt.table.schema.value_or("public"));
+  const auto table = wrap_in_quotes(_stmt.table.name);
+  const auto colnames = internal::strings::join(
+      ", ",
+      internal::collect::vector(_stmt.columns | transform(wrap_in_quotes)));
+  return "SELECT " + colnames + " FROM " + schema + "." + table + " LIMIT 0;";
+}
+
 }  // namespace sqlgen::postgres
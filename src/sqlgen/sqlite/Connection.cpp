@@ -1,67 +1,132 @@
 #include "sqlgen/sqlite/Connection.hpp"
 
+#include <array>
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
 
 #include "sqlgen/internal/collect/vector.hpp"
+#include "sqlgen/internal/native_to_text.hpp"
 #include "sqlgen/internal/strings/strings.hpp"
 #include "sqlgen/sqlite/Iterator.hpp"
 #include "sqlgen/sqlite/to_sql.hpp"
 
 namespace sqlgen::sqlite {
 
-Result<Nothing> Connection::actual_insert(
-    const std::vector<std::vector<std::optional<std::string>>>& _data,
-    sqlite3_stmt* _stmt) const noexcept {
-  for (const auto& row : _data) {
-    const auto num_cols = static_cast<int>(row.size());
-
-    for (int i = 0; i < num_cols; ++i) {
-      if (row[i]) {
-        const auto res =
-            sqlite3_bind_text(_stmt, i + 1, row[i]->c_str(),
-                              static_cast<int>(row[i]->size()), SQLITE_STATIC);
-        if (res != SQLITE_OK) {
-          return error(sqlite3_errmsg(conn_.get()));
-        }
-      } else {
-        const auto res = sqlite3_bind_null(_stmt, i + 1);
-        if (res != SQLITE_OK) {
-          return error(sqlite3_errmsg(conn_.get()));
-        }
+Result<Nothing> Connection::actual_insert(const RowBatch& _data,
+                                          sqlite3_stmt* _stmt) const noexcept {
+  const auto insert_rows = [&]() -> Result<Nothing> {
+    for (size_t i = 0; i < _data.size(); ++i) {
+      const auto bound = bind_row(_data[i], _stmt, SQLITE_STATIC);
+      if (!bound) {
+        return bound;
       }
-    }
 
-    auto res = sqlite3_step(_stmt);
-    if (res != SQLITE_OK && res != SQLITE_ROW && res != SQLITE_DONE) {
-      return error(sqlite3_errmsg(conn_.get()));
+      auto res = sqlite3_step(_stmt);
+      if (res != SQLITE_OK && res != SQLITE_ROW && res != SQLITE_DONE) {
+        return error(sqlite3_errmsg(conn_.get()));
+      }
+
+      res = sqlite3_reset(_stmt);
+      if (res != SQLITE_OK) {
+        return error(sqlite3_errmsg(conn_.get()));
+      }
     }
+    return Nothing{};
+  };
+
+  const auto result = insert_rows();
+
+  // The statement is cached, so it must be reset on every path, or the next
+  // insert using it would fail with SQLITE_MISUSE.
+  sqlite3_reset(_stmt);
+  sqlite3_clear_bindings(_stmt);
 
-    res = sqlite3_reset(_stmt);
+  return result;
+}
+
+Result<Nothing> Connection::begin_transaction() noexcept {
+  return execute("BEGIN TRANSACTION;");
+}
+
+Result<Nothing> Connection::bind_row(
+    const RowBatch::Row& _row, sqlite3_stmt* _stmt,
+    const sqlite3_destructor_type _text_destructor) const noexcept {
+  std::array<char, 32> buf{};
+
+  const auto num_cols = static_cast<int>(_row.size());
+
+  for (int j = 0; j < num_cols; ++j) {
+    const auto cell = _row[j];
+    int res = SQLITE_OK;
+    switch (cell.kind()) {
+      case RowBatch::Cell::Kind::null_value:
+        res = sqlite3_bind_null(_stmt, j + 1);
+        break;
+
+      case RowBatch::Cell::Kind::int64:
+        res = sqlite3_bind_int64(_stmt, j + 1, cell.int64());
+        break;
+
+      case RowBatch::Cell::Kind::float64:
+        res = sqlite3_bind_double(_stmt, j + 1, cell.float64());
+        break;
+
+      case RowBatch::Cell::Kind::text:
+        res = sqlite3_bind_text(_stmt, j + 1, cell.text().data(),
+                                static_cast<int>(cell.text().size()),
+                                _text_destructor);
+        break;
+
+      default: {
+        const auto str = internal::native_to_text(cell, &buf);
+        if (!str) {
+          return error(str.error().what());
+        }
+        res = sqlite3_bind_text(_stmt, j + 1, str->data(),
+                                static_cast<int>(str->size()),
+                                SQLITE_TRANSIENT);
+        break;
+      }
+    }
     if (res != SQLITE_OK) {
       return error(sqlite3_errmsg(conn_.get()));
     }
   }
 
-  const auto res = sqlite3_clear_bindings(_stmt);
-  if (res != SQLITE_OK) {
-    return error(sqlite3_errmsg(conn_.get()));
-  }
-
   return Nothing{};
 }
 
-Result<Nothing> Connection::begin_transaction() noexcept {
-  return execute("BEGIN TRANSACTION;");
+Result<Nothing> Connection::bind_params(const RowBatch& _params,
+                                        sqlite3_stmt* _stmt) const noexcept {
+  if (_params.size() == 0) {
+    return Nothing{};
+  }
+  // The iterator keeps stepping through the statement after the parameters
+  // have gone out of scope, so SQLite needs to copy them.
+  return bind_row(_params[0], _stmt, SQLITE_TRANSIENT);
 }
 
 Result<Nothing> Connection::commit() noexcept { return execute("COMMIT;"); }
 
+Result<Connection::StmtPtr> Connection::get_statement(
+    const std::string& _sql) noexcept {
+  const auto stmt = stmt_cache_.get(
+      _sql, [this](const auto& _s) { return prepare_statement(_s); });
+
+  // The statement is still held by an iterator or an ongoing write, so
+  // it cannot be shared.
+  if (stmt && stmt->use_count() > 2) {
+    return prepare_statement(_sql);
+  }
+
+  return stmt;
+}
+
 rfl::Result<Ref<Connection>> Connection::make(
-    const std::string& _fname) noexcept {
+    const std::string& _fname, const size_t _statement_cache_size) noexcept {
   try {
-    return Ref<Connection>::make(_fname);
+    return Ref<Connection>::make(_fname, _statement_cache_size);
   } catch (std::exception& e) {
     return error(e.what());
   }
@@ -78,12 +143,39 @@ Result<Nothing> Connection::execute(const std::string& _sql) noexcept {
   return Nothing{};
 }
 
-Result<Nothing> Connection::insert(
-    const dynamic::Insert& _stmt,
-    const std::vector<std::vector<std::optional<std::string>>>&
-        _data) noexcept {
+Result<Nothing> Connection::execute(const std::string& _sql,
+                                    const RowBatch& _params) noexcept {
+  const auto run = [&](const StmtPtr& _p_stmt) -> Result<Nothing> {
+    const auto stmt = _p_stmt.get();
+
+    auto res = sqlite3_step(stmt);
+    while (res == SQLITE_ROW) {
+      res = sqlite3_step(stmt);
+    }
+
+    Result<Nothing> result = Nothing{};
+    if (res != SQLITE_DONE) {
+      result = error("Executing '" + _sql +
+                     "' failed: " + sqlite3_errmsg(conn_.get()));
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    return result;
+  };
+
+  return get_statement(_sql).and_then([&](auto&& _p_stmt) {
+    return bind_params(_params, _p_stmt.get()).and_then([&](const auto&) {
+      return run(_p_stmt);
+    });
+  });
+}
+
+Result<Nothing> Connection::insert(const dynamic::Insert& _stmt,
+                                   const RowBatch& _data) noexcept {
   const auto sql = to_sql_impl(_stmt);
-  return prepare_statement(sql).and_then(
+  return get_statement(sql).and_then(
       [&](auto _p_stmt) { return actual_insert(_data, _p_stmt.get()); });
 }
 
@@ -98,22 +190,20 @@ typename Connection::ConnPtr Connection::make_conn(const std::string& _fname) {
 }
 
 Result<Ref<IteratorBase>> Connection::read(const dynamic::SelectFrom& _query) {
-  const auto sql = to_sql_impl(_query);
-
-  sqlite3_stmt* p_stmt = nullptr;
-
-  sqlite3_prepare(conn_.get(), /* Database handle */
-                  sql.c_str(), /* SQL statement, UTF-8 encoded */
-                  sql.size(),  /* Maximum length of zSql in bytes. */
-                  &p_stmt,     /* OUT: Statement handle */
-                  nullptr      /* OUT: Pointer to unused portion of zSql */
-  );
-
-  if (!p_stmt) {
-    return error(sqlite3_errmsg(conn_.get()));
-  }
+  return read(to_sql_impl(_query), RowBatch());
+}
 
-  return Ref<sqlite3_stmt>::make(StmtPtr(p_stmt, &sqlite3_finalize))
+Result<Ref<IteratorBase>> Connection::read(const std::string& _sql,
+                                           const RowBatch& _params) {
+  const auto bind = [&](auto&& _stmt) {
+    return bind_params(_params, _stmt.get()).transform([&](const auto&) {
+      return _stmt;
+    });
+  };
+
+  return get_statement(_sql)
+      .and_then(bind)
+      .and_then([](auto&& _stmt) { return Ref<sqlite3_stmt>::make(_stmt); })
       .transform([&](auto _stmt) -> Ref<IteratorBase> {
         return Ref<Iterator>::make(_stmt, conn_);
       });
@@ -123,11 +213,15 @@ Result<Connection::StmtPtr> Connection::prepare_statement(
     const std::string& _sql) const noexcept {
   sqlite3_stmt* p_stmt = nullptr;
 
-  sqlite3_prepare(conn_.get(),  /* Database handle */
-                  _sql.c_str(), /* SQL statement, UTF-8 encoded */
-                  _sql.size(),  /* Maximum length of zSql in bytes. */
-                  &p_stmt,      /* OUT: Statement handle */
-                  nullptr       /* OUT: Pointer to unused portion of zSql */
+  // Statements are kept in the cache, so SQLite should not expect them
+  // to be short-lived.
+  sqlite3_prepare_v3(
+      conn_.get(),                    /* Database handle */
+      _sql.c_str(),                   /* SQL statement, UTF-8 encoded */
+      static_cast<int>(_sql.size()),  /* Maximum length of zSql in bytes. */
+      SQLITE_PREPARE_PERSISTENT,      /* Zero or more SQLITE_PREPARE_ flags */
+      &p_stmt,                        /* OUT: Statement handle */
+      nullptr /* OUT: Pointer to unused portion of zSql */
   );
 
   if (!p_stmt) {
@@ -149,7 +243,7 @@ Result<Nothing> Connection::start_write(const dynamic::Write& _stmt) {
 
   const auto sql = to_sql_impl(_stmt);
 
-  return prepare_statement(sql)
+  return get_statement(sql)
       .transform([&](auto&& _stmt) {
         stmt_ = std::move(_stmt);
         return Nothing{};
@@ -157,8 +251,7 @@ Result<Nothing> Connection::start_write(const dynamic::Write& _stmt) {
       .and_then([&](const auto&) { return begin_transaction(); });
 }
 
-Result<Nothing> Connection::write(
-    const std::vector<std::vector<std::optional<std::string>>>& _data) {
+Result<Nothing> Connection::write(const RowBatch& _data) {
   if (!stmt_) {
     return error(
         " You need to call .start_write(...) before you can call "
@@ -3,6 +3,8 @@
 #include <ranges>
 #include <rfl.hpp>
 #include <sstream>
+#include <string_view>
+#include <type_traits>
 
 #include "sqlgen/internal/collect/vector.hpp"
 #include "sqlgen/internal/strings/strings.hpp"
@@ -19,33 +21,47 @@ Iterator::Iterator(const StmtPtr& _stmt, const ConnPtr& _conn)
   step();
 }
 
-Iterator::~Iterator() = default;
+// Resets the statement, so the connection can reuse it.
+Iterator::~Iterator() { sqlite3_reset(stmt_.get()); }
 
 bool Iterator::end() const { return end_; }
 
-Result<std::vector<std::vector<std::optional<std::string>>>> Iterator::next(
-    const size_t _batch_size) {
+Result<RowBatch> Iterator::next(const size_t _batch_size) {
   if (end()) {
     return error("End is reached.");
   }
 
-  std::vector<std::vector<std::optional<std::string>>> batch;
+  RowBatch batch(static_cast<size_t>(num_cols_));
 
-  for (size_t i = 0; i < _batch_size; ++i) {
-    std::vector<std::optional<std::string>> new_row;
+  const bool has_native = is_native_.size() == static_cast<size_t>(num_cols_);
 
+  for (size_t i = 0; i < _batch_size; ++i) {
     for (int j = 0; j < num_cols_; ++j) {
+      const auto type = sqlite3_column_type(stmt_.get(), j);
+      if (type == SQLITE_NULL) {
+        batch.push_null();
+        continue;
+      }
+      if (has_native && is_native_[j]) {
+        if (type == SQLITE_INTEGER) {
+          batch.push_int64(sqlite3_column_int64(stmt_.get(), j));
+          continue;
+        }
+        if (type == SQLITE_FLOAT) {
+          batch.push_float64(sqlite3_column_double(stmt_.get(), j));
+          continue;
+        }
+      }
       auto ptr = sqlite3_column_text(stmt_.get(), j);
       if (ptr) {
-        new_row.emplace_back(
-            std::string(std::launder(reinterpret_cast<const char*>(ptr))));
+        batch.push_back(std::string_view(
+            std::launder(reinterpret_cast<const char*>(ptr)),
+            static_cast<size_t>(sqlite3_column_bytes(stmt_.get(), j))));
       } else {
-        new_row.emplace_back(std::nullopt);
+        batch.push_null();
       }
     }
 
-    batch.emplace_back(std::move(new_row));
-
     step();
 
     if (end()) {
@@ -56,4 +72,24 @@ Result<std::vector<std::vector<std::optional<std::string>>>> Iterator::next(
   return batch;
 }
 
+void Iterator::set_column_types(const std::vector<dynamic::Type>& _types) {
+  is_native_.clear();
+  for (const auto& type : _types) {
+    is_native_.push_back(type.visit([](const auto& _t) {
+      using T = std::remove_cvref_t<decltype(_t)>;
+      return std::is_same_v<T, dynamic::types::Boolean> ||
+             std::is_same_v<T, dynamic::types::Float32> ||
+             std::is_same_v<T, dynamic::types::Float64> ||
+             std::is_same_v<T, dynamic::types::Int8> ||
+             std::is_same_v<T, dynamic::types::Int16> ||
+             std::is_same_v<T, dynamic::types::Int32> ||
+             std::is_same_v<T, dynamic::types::Int64> ||
+             std::is_same_v<T, dynamic::types::UInt8> ||
+             std::is_same_v<T, dynamic::types::UInt16> ||
+             std::is_same_v<T, dynamic::types::UInt32> ||
+             std::is_same_v<T, dynamic::types::UInt64>;
+    }));
+  }
+}
+
 }  // namespace sqlgen::sqlite
@@ -108,7 +108,10 @@ std::string column_or_value_to_sql(
     const dynamic::ColumnOrValue& _col) noexcept {
   const auto handle_value = [](const auto& _v) -> std::string {
     using Type = std::remove_cvref_t<decltype(_v)>;
-    if constexpr (std::is_same_v<Type, dynamic::String>) {
+    if constexpr (std::is_same_v<Type, dynamic::Param>) {
+      return "?" + std::to_string(_v.ix);
+
+    } else if constexpr (std::is_same_v<Type, dynamic::String>) {
       return "'" + escape_single_quote(_v.val) + "'";
 
     } else if constexpr (std::is_same_v<Type, dynamic::Duration>) {
@@ -1,4 +1,11 @@
+#include "sqlgen/postgres/AsyncConnection.cpp"
 #include "sqlgen/postgres/Connection.cpp"
+#include "sqlgen/postgres/CopyIterator.cpp"
+#include "sqlgen/postgres/EventLoop.cpp"
 #include "sqlgen/postgres/Iterator.cpp"
+#include "sqlgen/postgres/ResultIterator.cpp"
+#include "sqlgen/postgres/StreamingIterator.cpp"
+#include "sqlgen/postgres/binary.cpp"
 #include "sqlgen/postgres/exec.cpp"
+#include "sqlgen/postgres/push_rows.cpp"
 #include "sqlgen/postgres/to_sql.cpp"
@@ -0,0 +1,53 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/mysql.hpp>
+#include <string>
+#include <vector>
+
+namespace test_insert_large_rows {
+
+struct Document {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string content;
+};
+
+TEST(mysql, test_insert_large_rows) {
+  // About 6 MiB in total, so the rows must be split into several statements
+  // to stay below the packet limit.
+  auto docs1 = std::vector<Document>();
+  for (uint32_t i = 0; i < 600; ++i) {
+    const auto c = static_cast<char>('a' + i % 26);
+    docs1.emplace_back(Document{.id = i, .content = std::string(10000, c)});
+  }
+
+  const auto credentials = sqlgen::mysql::Credentials{.host = "localhost",
+                                                      .user = "sqlgen",
+                                                      .password = "password",
+                                                      .dbname = "mysql"};
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto docs2 = sqlgen::mysql::connect(credentials)
+                         .and_then(drop<Document> | if_exists)
+                         .and_then(begin_transaction)
+                         .and_then(create_table<Document> | if_not_exists)
+                         .and_then(insert(std::ref(docs1)))
+                         .and_then(commit)
+                         .and_then(sqlgen::read<std::vector<Document>> |
+                                   order_by("id"_c))
+                         .value();
+
+  ASSERT_EQ(docs2.size(), docs1.size());
+  for (size_t i = 0; i < docs1.size(); ++i) {
+    EXPECT_EQ(docs2[i].content, docs1[i].content);
+  }
+}
+
+}  // namespace test_insert_large_rows
+
+#endif
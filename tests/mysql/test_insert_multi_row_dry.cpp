@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/dynamic/Insert.hpp>
+#include <sqlgen/mysql.hpp>
+#include <sqlgen/transpilation/to_insert_or_write.hpp>
+
+namespace test_insert_multi_row_dry {
+
+struct TestTable {
+  std::string field1;
+  int32_t field2;
+  sqlgen::PrimaryKey<uint32_t> id;
+};
+
+TEST(mysql, test_insert_multi_row_dry) {
+  auto insert_stmt = sqlgen::transpilation::to_insert_or_write<
+      TestTable, sqlgen::dynamic::Insert>(true);
+  insert_stmt.num_rows = 3;
+
+  const auto expected =
+      R"(INSERT INTO `TestTable` (`field1`, `field2`, `id`) VALUES (?, ?, ?), (?, ?, ?), (?, ?, ?) ON DUPLICATE KEY UPDATE field1=VALUES(field1), field2=VALUES(field2), id=VALUES(id);)";
+
+  EXPECT_EQ(sqlgen::mysql::to_sql(sqlgen::dynamic::Statement(insert_stmt)),
+            expected);
+}
+}  // namespace test_insert_multi_row_dry
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/mysql.hpp>
+#include <string>
+#include <vector>
+
+namespace test_prepare_dry {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+struct ByName {
+  std::string name;
+  int age;
+};
+
+struct ById {
+  uint32_t id;
+};
+
+TEST(mysql, test_prepare_dry) {
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  // The string literal looks like a placeholder, but must be skipped.
+  const auto by_name = prepare<ByName>(
+      read<std::vector<Person>> |
+      where(("last_name"_c == param<"name">() && "age"_c < param<"age">()) &&
+            ("first_name"_c == "Who?/*2*/" ||
+             "first_name"_c == param<"name">())));
+
+  const auto sql = mysql::to_sql(by_name.statement());
+
+  const auto expected_read =
+      R"(SELECT `id`, `first_name`, `last_name`, `age` FROM `Person` WHERE ((`last_name` = ?/*1*/) AND (`age` < ?/*2*/)) AND ((`first_name` = 'Who?/*2*/') OR (`first_name` = ?/*1*/)))";
+
+  EXPECT_EQ(sql, expected_read);
+  EXPECT_EQ(by_name.names(), std::vector<std::string>({"name", "age"}));
+
+  // The values are bound in the order of the placeholders, so the value of
+  // the repeated parameter is bound twice.
+  RowBatch params(2);
+  params.push_back("Simpson");
+  params.push_int64(18);
+
+  const auto ordered = mysql::Connection::order_params(sql, params).value();
+
+  ASSERT_EQ(ordered.num_cols(), 3);
+  EXPECT_EQ(ordered[0][0].text(), "Simpson");
+  EXPECT_EQ(ordered[0][1].int64(), 18);
+  EXPECT_EQ(ordered[0][2].text(), "Simpson");
+
+  const auto by_id =
+      prepare<ById>(delete_from<Person> | where("id"_c == param<"id">()));
+
+  const auto expected_delete = R"(DELETE FROM `Person` WHERE `id` = ?/*1*/;)";
+
+  EXPECT_EQ(mysql::to_sql(by_id.statement()), expected_delete);
+}
+
+}  // namespace test_prepare_dry
@@ -0,0 +1,80 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/mysql.hpp>
+#include <vector>
+
+namespace test_statement_cache {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(mysql, test_statement_cache) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{
+           .id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10}});
+
+  const auto people2 = std::vector<Person>(
+      {Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
+
+  const auto people3 = std::vector<Person>(
+      {Person{.id = 4, .first_name = "Ned", .last_name = "Flanders", .age = 60},
+       Person{
+           .id = 5, .first_name = "Maude", .last_name = "Flanders", .age = 55}});
+
+  const auto credentials = sqlgen::mysql::Credentials{.host = "localhost",
+                                                      .user = "sqlgen",
+                                                      .password = "password",
+                                                      .dbname = "mysql"};
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::mysql::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(std::ref(people1)))
+                        .and_then(insert(std::ref(people2)));
+
+  const auto stats1 = conn.value()->statement_cache_stats();
+
+  EXPECT_EQ(stats1.capacity, 100);
+  EXPECT_EQ(stats1.hits, 1);
+  EXPECT_EQ(stats1.misses, 1);
+  EXPECT_EQ(stats1.size, 1);
+
+  // A write of the same number of rows generates the same INSERT
+  // statement, so it reuses the one prepared by the inserts.
+  sqlgen::write(conn, people3).value();
+
+  const auto stats2 = conn.value()->statement_cache_stats();
+
+  EXPECT_EQ(stats2.hits, 2);
+  EXPECT_EQ(stats2.misses, 1);
+  EXPECT_EQ(stats2.size, 1);
+
+  const auto people4 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+  auto people5 = people1;
+  people5.insert(people5.end(), people2.begin(), people2.end());
+  people5.insert(people5.end(), people3.begin(), people3.end());
+
+  EXPECT_EQ(rfl::json::write(people4), rfl::json::write(people5));
+}
+
+}  // namespace test_statement_cache
+
+#endif
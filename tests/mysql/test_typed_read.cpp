@@ -0,0 +1,66 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/mysql.hpp>
+#include <string>
+#include <vector>
+
+namespace test_typed_read {
+
+struct Product {
+  sqlgen::PrimaryKey<int64_t> id;
+  int16_t small;
+  uint32_t count;
+  double price;
+  bool available;
+  std::optional<int> maybe;
+  std::string description;
+  sqlgen::Date release_date;
+  sqlgen::Timestamp<"%Y-%m-%d %H:%M:%S"> updated;
+};
+
+TEST(mysql, test_typed_read) {
+  auto products1 = std::vector<Product>();
+  for (int64_t i = 0; i < 10; ++i) {
+    products1.push_back(
+        Product{.id = i,
+                .small = static_cast<int16_t>(-i),
+                .count = 4000000000,
+                .price = 0.25 * static_cast<double>(i),
+                .available = i % 2 == 0,
+                .maybe = i % 3 == 0 ? std::optional<int>() : std::optional(7),
+                .description = std::string(100 * static_cast<size_t>(i), 'x'),
+                .release_date = "1999-12-31",
+                .updated = "2024-02-29 23:59:59"});
+  }
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto credentials = sqlgen::mysql::Credentials{.host = "localhost",
+                                                      .user = "sqlgen",
+                                                      .password = "password",
+                                                      .dbname = "mysql",
+                                                      .prefetch_rows = 3};
+
+  const auto conn =
+      sqlgen::mysql::connect(credentials).and_then(drop<Product> | if_exists);
+
+  const auto products2 =
+      sqlgen::write(conn, products1)
+          .and_then(sqlgen::read<std::vector<Product>> | order_by("id"_c))
+          .value();
+
+  const auto json1 = rfl::json::write(products1);
+  const auto json2 = rfl::json::write(products2);
+
+  EXPECT_EQ(json1, json2);
+}
+
+}  // namespace test_typed_read
+
+#endif
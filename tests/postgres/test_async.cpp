@@ -0,0 +1,84 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+
+namespace test_async {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(postgres, test_async) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10},
+       Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0},
+       Person{
+           .id = 4, .first_name = "Hugo", .last_name = "Simpson", .age = 10}});
+
+  const auto credentials = sqlgen::postgres::Credentials{.user = "postgres",
+                                                         .password = "password",
+                                                         .host = "localhost",
+                                                         .dbname = "postgres"};
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn =
+      sqlgen::postgres::connect(credentials).and_then(drop<Person> | if_exists);
+
+  sqlgen::write(conn, people1).value();
+
+  sqlgen::postgres::EventLoop loop;
+
+  std::vector<Person> children;
+  Person homer;
+
+  const auto read_children = [&]() -> Task<Nothing> {
+    const auto async_conn =
+        (co_await sqlgen::postgres::connect_async(&loop, credentials)).value();
+    children = (co_await (sqlgen::read<std::vector<Person>> |
+                          where("age"_c < 18) | order_by("id"_c))(async_conn))
+                   .value();
+    co_return Nothing{};
+  };
+
+  const auto read_homer = [&]() -> Task<Nothing> {
+    const auto async_conn =
+        (co_await sqlgen::postgres::connect_async(&loop, credentials)).value();
+    (co_await (update<Person>("age"_c.set(46)) |
+               where("first_name"_c == "Homer"))(async_conn))
+        .value();
+    homer = (co_await (sqlgen::read<Person> |
+                       where("first_name"_c == "Homer"))(async_conn))
+                .value();
+    co_return Nothing{};
+  };
+
+  // Both tasks are in flight at the same time, on a single thread.
+  loop.spawn(read_children());
+  loop.spawn(read_homer());
+  loop.run();
+
+  const std::string expected_children =
+      R"([{"id":1,"first_name":"Bart","last_name":"Simpson","age":10},{"id":2,"first_name":"Lisa","last_name":"Simpson","age":8},{"id":3,"first_name":"Maggie","last_name":"Simpson","age":0},{"id":4,"first_name":"Hugo","last_name":"Simpson","age":10}])";
+
+  EXPECT_EQ(rfl::json::write(children), expected_children);
+  EXPECT_EQ(homer.age, 46);
+}
+
+}  // namespace test_async
+
+#endif
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace test_async_exception_dry {
+
+TEST(postgres, test_async_exception_dry) {
+  using namespace sqlgen;
+
+  sqlgen::postgres::EventLoop loop;
+
+  const auto succeed = []() -> Task<Nothing> { co_return Nothing{}; };
+
+  const auto fail = [](const std::string _msg) -> Task<Nothing> {
+    throw std::runtime_error(_msg);
+    co_return Nothing{};
+  };
+
+  loop.spawn(succeed());
+  loop.spawn(fail("first"));
+  loop.spawn(fail("second"));
+
+  // Of the tasks that failed, the exception of the one spawned first is
+  // rethrown.
+  try {
+    loop.run();
+    FAIL() << "Expected an exception.";
+  } catch (const std::runtime_error& e) {
+    EXPECT_EQ(std::string(e.what()), "first");
+  }
+
+  // The failed tasks are gone after .run() has returned.
+  loop.spawn(succeed());
+  EXPECT_NO_THROW(loop.run());
+}
+
+}  // namespace test_async_exception_dry
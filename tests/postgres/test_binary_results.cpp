@@ -0,0 +1,80 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+
+namespace test_binary_results {
+
+enum class Category { cheap, expensive };
+
+struct Product {
+  sqlgen::PrimaryKey<int64_t> id;
+  int16_t small;
+  int32_t count;
+  float ratio;
+  double price;
+  bool available;
+  std::optional<int> maybe;
+  std::string name;
+  Category category;
+  sqlgen::Date release_date;
+  sqlgen::Timestamp<"%Y-%m-%d %H:%M:%S"> updated;
+};
+
+TEST(postgres, test_binary_results) {
+  const auto products1 =
+      std::vector<Product>({Product{.id = 1,
+                                    .small = -7,
+                                    .count = 100000,
+                                    .ratio = 0.5f,
+                                    .price = 19.25,
+                                    .available = true,
+                                    .maybe = 3,
+                                    .name = "Donut",
+                                    .category = Category::cheap,
+                                    .release_date = "1999-12-31",
+                                    .updated = "2024-02-29 23:59:59"},
+                            Product{.id = 2,
+                                    .small = 7,
+                                    .count = -1,
+                                    .ratio = -2.25f,
+                                    .price = 1.0e10,
+                                    .available = false,
+                                    .maybe = std::nullopt,
+                                    .name = "Duff",
+                                    .category = Category::expensive,
+                                    .release_date = "2000-01-01",
+                                    .updated = "1970-01-01 00:00:00"}});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto credentials =
+      sqlgen::postgres::Credentials{.user = "postgres",
+                                    .password = "password",
+                                    .host = "localhost",
+                                    .dbname = "postgres",
+                                    .binary_results = true};
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Product> | if_exists);
+
+  const auto products2 =
+      sqlgen::write(conn, products1)
+          .and_then(sqlgen::read<std::vector<Product>> | order_by("id"_c))
+          .value();
+
+  const auto json1 = rfl::json::write(products1);
+  const auto json2 = rfl::json::write(products2);
+
+  EXPECT_EQ(json1, json2);
+}
+
+}  // namespace test_binary_results
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <string>
+#include <vector>
+
+namespace test_copy_buffer {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(postgres, test_copy_buffer) {
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 10000; ++i) {
+    people1.emplace_back(Person{.id = i,
+                                .first_name = "Person" + std::to_string(i),
+                                .last_name = "Simpson",
+                                .age = static_cast<int>(i % 100)});
+  }
+
+  // A tiny buffer, so the rows are sent in many chunks. A chunk is sent as
+  // soon as a complete row makes the buffer exceed this size.
+  const auto credentials =
+      sqlgen::postgres::Credentials{.user = "postgres",
+                                    .password = "password",
+                                    .host = "localhost",
+                                    .dbname = "postgres",
+                                    .copy_buffer_size = 100};
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn =
+      postgres::connect(credentials).and_then(drop<Person> | if_exists);
+
+  const auto written = sqlgen::write(conn, people1);
+
+  ASSERT_TRUE(written);
+  EXPECT_GT(written.value()->num_copy_chunks(), 1000);
+
+  const auto people2 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(written).value();
+
+  const auto json1 = rfl::json::write(people1);
+  const auto json2 = rfl::json::write(people2);
+
+  EXPECT_EQ(json1, json2);
+}
+
+}  // namespace test_copy_buffer
+
+#endif
@@ -19,11 +19,11 @@ struct Parser<boost::uuids::uuid> {
   using Type = boost::uuids::uuid;
 
   static Result<boost::uuids::uuid> read(
-      const std::optional<std::string>& _str) noexcept {
+      const std::optional<std::string_view>& _str) noexcept {
     if (!_str) {
       return error("boost::uuids::uuid cannot be NULL.");
     }
-    return boost::lexical_cast<boost::uuids::uuid>(*_str);
+    return boost::lexical_cast<boost::uuids::uuid>(std::string(*_str));
   }
 
   static std::optional<std::string> write(
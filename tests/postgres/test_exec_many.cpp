@@ -0,0 +1,68 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+
+namespace test_exec_many {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  int age;
+};
+
+TEST(postgres, test_exec_many) {
+  // More rows than fit into a single pipeline.
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 2500; ++i) {
+    people1.push_back(
+        Person{.id = i, .first_name = "Person" + std::to_string(i), .age = 1});
+  }
+
+  const auto credentials = sqlgen::postgres::Credentials{.user = "postgres",
+                                                         .password = "password",
+                                                         .host = "localhost",
+                                                         .dbname = "postgres"};
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person>)
+                        .and_then(insert(std::ref(people1)))
+                        .and_then(exec_many(
+                            {R"(UPDATE "Person" SET "age" = 2 WHERE "id" < 10;)",
+                             R"(DELETE FROM "Person" WHERE "id" >= 2000;)"}));
+
+  const auto query = sqlgen::read<std::vector<Person>> | order_by("id"_c);
+
+  const auto people2 = query(conn).value();
+
+  ASSERT_EQ(people2.size(), 2000);
+  EXPECT_EQ(people2.at(0).age, 2);
+  EXPECT_EQ(people2.at(10).age, 1);
+  EXPECT_EQ(people2.at(1999).first_name, "Person1999");
+
+  // The first failing statement is reported and the connection remains
+  // usable afterwards. Statements in the same pipeline run in an implicit
+  // transaction, so the first DELETE is rolled back as well.
+  const auto res = exec_many(
+      conn, {R"(DELETE FROM "Person" WHERE "id" = 0;)",
+             R"(DELETE FROM "NoSuchTable";)",
+             R"(DELETE FROM "Person" WHERE "id" = 1;)"});
+
+  EXPECT_FALSE(res);
+
+  const auto people3 = sqlgen::read<std::vector<Person>>(conn).value();
+
+  EXPECT_EQ(people3.size(), 2000);
+}
+
+}  // namespace test_exec_many
+
+#endif
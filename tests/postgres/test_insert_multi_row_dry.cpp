@@ -0,0 +1,27 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/dynamic/Insert.hpp>
+#include <sqlgen/postgres.hpp>
+#include <sqlgen/transpilation/to_insert_or_write.hpp>
+
+namespace test_insert_multi_row_dry {
+
+struct TestTable {
+  std::string field1;
+  int32_t field2;
+  sqlgen::PrimaryKey<uint32_t> id;
+};
+
+TEST(postgres, test_insert_multi_row_dry) {
+  auto insert_stmt = sqlgen::transpilation::to_insert_or_write<
+      TestTable, sqlgen::dynamic::Insert>(true);
+  insert_stmt.num_rows = 3;
+
+  const auto expected =
+      R"(INSERT INTO "TestTable" ("field1", "field2", "id") VALUES ($1, $2, $3), ($4, $5, $6), ($7, $8, $9) ON CONFLICT (id) DO UPDATE SET field1=excluded.field1, field2=excluded.field2, id=excluded.id;)";
+
+  EXPECT_EQ(sqlgen::postgres::to_sql(sqlgen::dynamic::Statement(insert_stmt)),
+            expected);
+}
+}  // namespace test_insert_multi_row_dry
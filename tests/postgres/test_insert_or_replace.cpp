@@ -26,7 +26,12 @@ TEST(postgres, test_insert_or_replace) {
        Person{
            .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
 
-  const auto people2 = std::vector<Person>({Person{.id = 1,
+  // The same key appears twice, the last row wins.
+  const auto people2 = std::vector<Person>({Person{.id = 3,
+                                                   .first_name = "Maggie",
+                                                   .last_name = "Simpson",
+                                                   .age = 1},
+                                            Person{.id = 1,
                                                    .first_name = "Bartholomew",
                                                    .last_name = "Simpson",
                                                    .age = 10},
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <string>
+#include <vector>
+
+namespace test_prepare_dry {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+struct ByName {
+  std::string name;
+  int age;
+};
+
+struct ById {
+  uint32_t id;
+};
+
+TEST(postgres, test_prepare_dry) {
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  // The same parameter is used twice, but only bound once.
+  const auto by_name = prepare<ByName>(
+      read<std::vector<Person>> |
+      where(("first_name"_c == param<"name">() ||
+             "last_name"_c == param<"name">()) &&
+            "age"_c < param<"age">()));
+
+  const auto expected_read =
+      R"(SELECT "id", "first_name", "last_name", "age" FROM "Person" WHERE (("first_name" = $1) OR ("last_name" = $1)) AND ("age" < $2))";
+
+  EXPECT_EQ(postgres::to_sql(by_name.statement()), expected_read);
+  EXPECT_EQ(by_name.names(), std::vector<std::string>({"name", "age"}));
+
+  const auto by_id =
+      prepare<ById>(delete_from<Person> | where("id"_c == param<"id">()));
+
+  const auto expected_delete = R"(DELETE FROM "Person" WHERE "id" = $1;)";
+
+  EXPECT_EQ(postgres::to_sql(by_id.statement()), expected_delete);
+  EXPECT_EQ(by_id.names(), std::vector<std::string>({"id"}));
+}
+
+}  // namespace test_prepare_dry
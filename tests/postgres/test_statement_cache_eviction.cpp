@@ -0,0 +1,93 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+
+namespace test_statement_cache_eviction {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+/// The statements prepared by the current session.
+struct PreparedStatement {
+  static constexpr const char* tablename = "pg_prepared_statements";
+
+  std::string name;
+};
+
+TEST(postgres, test_statement_cache_eviction) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10},
+       Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
+
+  const auto people2 = std::vector<Person>(
+      {Person{.id = 4, .first_name = "Ned", .last_name = "Flanders", .age = 60},
+       Person{
+           .id = 5, .first_name = "Maude", .last_name = "Flanders", .age = 55}});
+
+  const auto people3 = std::vector<Person>(
+      {Person{.id = 6, .first_name = "Rod", .last_name = "Flanders", .age = 10},
+       Person{.id = 7, .first_name = "Todd", .last_name = "Flanders", .age = 8},
+       Person{
+           .id = 8, .first_name = "Moe", .last_name = "Szyslak", .age = 50},
+       Person{
+           .id = 9, .first_name = "Barney", .last_name = "Gumble", .age = 40}});
+
+  const auto credentials =
+      sqlgen::postgres::Credentials{.user = "postgres",
+                                    .password = "password",
+                                    .host = "localhost",
+                                    .dbname = "postgres",
+                                    .statement_cache_size = 1};
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  // Every insert needs a statement for a different number of rows, so each
+  // one evicts the statement of the previous one.
+  const auto conn = sqlgen::postgres::connect(credentials)
+                        .and_then(drop<Person> | if_exists)
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(std::ref(people1)))
+                        .and_then(insert(std::ref(people2)))
+                        .and_then(insert(std::ref(people3)));
+
+  const auto stats = conn.value()->statement_cache_stats();
+
+  EXPECT_EQ(stats.capacity, 1);
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.size, 1);
+
+  // The evicted statements have been deallocated on the server.
+  const auto prepared =
+      sqlgen::read<std::vector<PreparedStatement>>(conn).value();
+
+  EXPECT_EQ(prepared.size(), 1);
+
+  const auto people4 =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+  auto people5 = people1;
+  people5.insert(people5.end(), people2.begin(), people2.end());
+  people5.insert(people5.end(), people3.begin(), people3.end());
+
+  EXPECT_EQ(rfl::json::write(people4), rfl::json::write(people5));
+}
+
+}  // namespace test_statement_cache_eviction
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SQLGEN_BUILD_DRY_TESTS_ONLY
+
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/postgres.hpp>
+#include <vector>
+
+namespace test_stream_in_transaction {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(postgres, test_stream_in_transaction) {
+  // Enough rows that the query is still running when the range is
+  // destroyed.
+  auto people1 = std::vector<Person>();
+  for (uint32_t i = 0; i < 20000; ++i) {
+    people1.push_back(Person{.id = i,
+                             .first_name = "Homer",
+                             .last_name = "Simpson",
+                             .age = static_cast<int>(i % 100)});
+  }
+
+  const auto credentials =
+      sqlgen::postgres::Credentials{.user = "postgres",
+                                    .password = "password",
+                                    .host = "localhost",
+                                    .dbname = "postgres",
+                                    .read_mode =
+                                        sqlgen::postgres::ReadMode::stream};
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn =
+      postgres::connect(credentials).and_then(drop<Person> | if_exists);
+
+  sqlgen::write(conn, people1).value();
+
+  const auto txn = begin_transaction(conn).value();
+
+  for (const auto& person : sqlgen::read<sqlgen::Range<Person>>(txn).value()) {
+    EXPECT_TRUE(person);
+    break;
+  }
+
+  // Stopping early must not abort the transaction.
+  const auto committed =
+      (delete_from<Person> | where("age"_c >= 50))(txn).and_then(commit);
+
+  EXPECT_TRUE(committed);
+
+  const auto people2 = sqlgen::read<std::vector<Person>>(conn).value();
+
+  EXPECT_EQ(people2.size(), 10000);
+}
+
+}  // namespace test_stream_in_transaction
+
+#endif
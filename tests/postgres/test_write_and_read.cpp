@@ -2,10 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <optional>
 #include <rfl.hpp>
 #include <rfl/json.hpp>
 #include <sqlgen.hpp>
 #include <sqlgen/postgres.hpp>
+#include <string>
 #include <vector>
 
 namespace test_write_and_read {
@@ -17,6 +19,21 @@ struct Person {
   int age;
 };
 
+/// Covers all types that have a binary encoding, as well as strings that
+/// need to be escaped in the text format.
+struct Product {
+  sqlgen::PrimaryKey<int64_t> id;
+  int16_t small;
+  int32_t count;
+  float ratio;
+  double price;
+  bool available;
+  std::optional<int> maybe;
+  std::string name;
+  sqlgen::Date release_date;
+  sqlgen::Timestamp<"%Y-%m-%d %H:%M:%S"> updated;
+};
+
 TEST(postgres, test_write_and_read) {
   const auto people1 = std::vector<Person>(
       {Person{
@@ -26,25 +43,85 @@ TEST(postgres, test_write_and_read) {
        Person{
            .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
 
+  const auto products1 =
+      std::vector<Product>({Product{.id = 1,
+                                    .small = -7,
+                                    .count = 100000,
+                                    .ratio = 0.5f,
+                                    .price = 19.25,
+                                    .available = true,
+                                    .maybe = 3,
+                                    .name = "Tab\tnewline\nbackslash\\bell\a",
+                                    .release_date = "1999-12-31",
+                                    .updated = "2024-02-29 23:59:59"},
+                            Product{.id = 2,
+                                    .small = 7,
+                                    .count = -1,
+                                    .ratio = -2.25f,
+                                    .price = 1.0e10,
+                                    .available = false,
+                                    .maybe = std::nullopt,
+                                    .name = "Duff",
+                                    .release_date = "1969-07-20",
+                                    .updated = "1970-01-01 00:00:00"}});
+
+  using ReadMode = sqlgen::postgres::ReadMode;
+
   const auto credentials = sqlgen::postgres::Credentials{.user = "postgres",
                                                          .password = "password",
                                                          .host = "localhost",
                                                          .dbname = "postgres"};
 
+  // The same rows must survive the round trip in every combination of
+  // write and read formats.
+  auto all_credentials =
+      std::vector<sqlgen::postgres::Credentials>(6, credentials);
+  all_credentials[1].binary_copy = true;
+  all_credentials[2].binary_results = true;
+  all_credentials[3].read_mode = ReadMode::stream;
+  all_credentials[4].read_mode = ReadMode::copy;
+  all_credentials[5].binary_results = true;
+  all_credentials[5].read_mode = ReadMode::copy;
+
   using namespace sqlgen;
   using namespace sqlgen::literals;
 
-  const auto conn =
-      postgres::connect(credentials).and_then(drop<Person> | if_exists);
+  const auto json1 = rfl::json::write(people1);
+  const auto json2 = rfl::json::write(products1);
 
-  const auto people2 = sqlgen::write(conn, people1)
-                           .and_then(sqlgen::read<std::vector<Person>>)
-                           .value();
+  for (size_t i = 0; i < all_credentials.size(); ++i) {
+    SCOPED_TRACE("credentials #" + std::to_string(i));
 
-  const auto json1 = rfl::json::write(people1);
-  const auto json2 = rfl::json::write(people2);
+    const auto conn = postgres::connect(all_credentials[i])
+                          .and_then(drop<Person> | if_exists)
+                          .and_then(drop<Product> | if_exists);
+
+    const auto people2 = sqlgen::write(conn, people1)
+                             .and_then(sqlgen::read<std::vector<Person>>)
+                             .value();
+
+    EXPECT_EQ(rfl::json::write(people2), json1);
+
+    const auto products2 =
+        sqlgen::write(conn, products1)
+            .and_then(sqlgen::read<std::vector<Product>> | order_by("id"_c) |
+                      batch_size(1))
+            .value();
+
+    EXPECT_EQ(rfl::json::write(products2), json2);
+
+    // Stopping early must leave the connection usable.
+    for (const auto& product :
+         sqlgen::read<sqlgen::Range<Product>>(conn).value()) {
+      EXPECT_TRUE(product);
+      break;
+    }
+
+    const auto products3 =
+        (sqlgen::read<std::vector<Product>> | order_by("id"_c))(conn).value();
 
-  EXPECT_EQ(json1, json2);
+    EXPECT_EQ(rfl::json::write(products3), json2);
+  }
 }
 
 }  // namespace test_write_and_read
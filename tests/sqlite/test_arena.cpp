@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+
+namespace test_arena {
+
+struct TestTable {
+  std::string field1;
+  int32_t field2;
+  sqlgen::PrimaryKey<uint32_t> id;
+};
+
+TEST(sqlite, test_arena) {
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto query =
+      read<std::vector<TestTable>> |
+      where(("field1"_c == "hello" || "field2"_c + 1 > 10) && "id"_c != 0);
+
+  const auto on_heap = sqlite::to_sql(transpilation::to_sql(query));
+
+  const auto in_arena = [&]() {
+    dynamic::Arena arena;
+    EXPECT_EQ(dynamic::Arena::current(), &arena);
+    return sqlite::to_sql(transpilation::to_sql(query));
+  }();
+
+  EXPECT_EQ(dynamic::Arena::current(), nullptr);
+
+  EXPECT_NE(on_heap.find("WHERE"), std::string::npos);
+  EXPECT_EQ(on_heap, in_arena);
+}
+}  // namespace test_arena
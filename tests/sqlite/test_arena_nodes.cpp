@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <type_traits>
+#include <vector>
+
+namespace test_arena_nodes {
+
+struct TestTable {
+  std::string field1;
+  int32_t field2;
+  sqlgen::PrimaryKey<uint32_t> id;
+};
+
+TEST(sqlite, test_arena_nodes) {
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto query = read<std::vector<TestTable>> |
+                     where("field1"_c == "hello" && "id"_c != 0);
+
+  // Returns the nodes the top-level AND condition refers to.
+  const auto get_nodes = [](const dynamic::Statement& _stmt) {
+    return _stmt.visit([](const auto& _s) {
+      using S = std::remove_cvref_t<decltype(_s)>;
+      std::vector<dynamic::NodeRef<dynamic::Condition>> nodes;
+      if constexpr (std::is_same_v<S, dynamic::SelectFrom>) {
+        _s.where->val.visit([&](const auto& _c) {
+          using C = std::remove_cvref_t<decltype(_c)>;
+          if constexpr (std::is_same_v<C, dynamic::Condition::And>) {
+            nodes = {_c.cond1, _c.cond2};
+          }
+        });
+      }
+      return nodes;
+    });
+  };
+
+  {
+    dynamic::Arena arena;
+    const auto stmt = transpilation::to_sql(query);
+    const auto nodes = get_nodes(stmt);
+
+    ASSERT_EQ(nodes.size(), 2);
+    EXPECT_FALSE(nodes[0].is_owning());
+    EXPECT_FALSE(nodes[1].is_owning());
+
+    // Copies point to the same node in the arena.
+    const auto copy = nodes[0];
+    EXPECT_FALSE(copy.is_owning());
+    EXPECT_EQ(copy.get(), nodes[0].get());
+  }
+
+  // Without an arena, the nodes are owned by the references.
+  const auto stmt = transpilation::to_sql(query);
+  const auto nodes = get_nodes(stmt);
+
+  ASSERT_EQ(nodes.size(), 2);
+  EXPECT_TRUE(nodes[0].is_owning());
+  EXPECT_TRUE(nodes[1].is_owning());
+
+  const auto node = dynamic::NodeRef<int>::make(42);
+  EXPECT_TRUE(node.is_owning());
+  EXPECT_EQ(*node, 42);
+}
+
+}  // namespace test_arena_nodes
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_batch_size {
+
+struct Document {
+  sqlgen::PrimaryKey<int64_t> id;
+  std::string content;
+};
+
+TEST(sqlite, test_batch_size) {
+  auto documents = std::vector<Document>();
+  for (int64_t i = 0; i < 1000; ++i) {
+    documents.push_back(
+        Document{.id = i, .content = std::string(static_cast<size_t>(i), 'x')});
+  }
+
+  using namespace sqlgen;
+
+  const auto conn = sqlite::connect().and_then(write(std::ref(documents)));
+
+  const auto fixed = read<std::vector<Document>> | batch_size(7);
+
+  const auto documents2 = fixed(conn).value();
+
+  ASSERT_EQ(documents2.size(), documents.size());
+  EXPECT_EQ(documents2.back().content, documents.back().content);
+
+  const auto adaptive =
+      read<Range<Document>> | adaptive_batch_size(4096, 1) | prefetch();
+
+  int64_t expected = 0;
+  for (const auto& res : adaptive(conn).value()) {
+    ASSERT_TRUE(res);
+    EXPECT_EQ(res->id(), expected);
+    EXPECT_EQ(res->content.size(), static_cast<size_t>(expected));
+    ++expected;
+  }
+  EXPECT_EQ(expected, 1000);
+}
+
+}  // namespace test_batch_size
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <thread>
+
+namespace test_connection_pool {
+
+TEST(sqlite, test_connection_pool) {
+  using namespace std::chrono_literals;
+
+  const auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                        sqlgen::ConnectionPoolConfig{.size = 1},
+                        std::string(":memory:"))
+                        .value();
+
+  auto session1 = std::make_optional(pool.try_acquire().value());
+
+  EXPECT_EQ(pool.available(), 0);
+  EXPECT_FALSE(pool.try_acquire());
+  EXPECT_FALSE(pool.acquire(10ms));
+
+  // The waiting thread should get the connection as soon as it is
+  // released, rather than after a fixed sleep.
+  auto waiter = std::thread([&]() {
+    const auto begin = std::chrono::steady_clock::now();
+    const auto session2 = pool.acquire(10s);
+    EXPECT_TRUE(session2);
+    EXPECT_LT(std::chrono::steady_clock::now() - begin, 5s);
+  });
+
+  std::this_thread::sleep_for(50ms);
+
+  session1.reset();
+
+  waiter.join();
+
+  EXPECT_EQ(pool.available(), 1);
+}
+
+}  // namespace test_connection_pool
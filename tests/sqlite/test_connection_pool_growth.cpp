@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+
+namespace test_connection_pool_growth {
+
+/// A clock that only moves when it is told to, so that the test does not
+/// need to sleep.
+struct TestClock {
+  using duration = std::chrono::steady_clock::duration;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<TestClock>;
+
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept { return time_point(elapsed); }
+
+  static inline duration elapsed = duration::zero();
+};
+
+TEST(sqlite, test_connection_pool_growth) {
+  using namespace std::chrono_literals;
+
+  const auto pool =
+      sqlgen::ConnectionPool<sqlgen::sqlite::Connection, TestClock>::make(
+          sqlgen::ConnectionPoolConfig{
+              .size = 3, .min_size = 1, .idle_timeout_in_seconds = 1},
+          std::string(":memory:"))
+          .value();
+
+  EXPECT_EQ(pool.size(), 3);
+  EXPECT_EQ(pool.num_open(), 1);
+  EXPECT_EQ(pool.available(), 3);
+
+  auto session1 = std::make_optional(pool.try_acquire().value());
+  auto session2 = std::make_optional(pool.try_acquire().value());
+  auto session3 = std::make_optional(pool.try_acquire().value());
+
+  EXPECT_EQ(pool.num_open(), 3);
+  EXPECT_EQ(pool.available(), 0);
+  EXPECT_FALSE(pool.try_acquire());
+
+  session1.reset();
+  session2.reset();
+  session3.reset();
+
+  EXPECT_EQ(pool.num_open(), 3);
+  EXPECT_EQ(pool.available(), 3);
+
+  // Not idle for long enough.
+  TestClock::elapsed += 500ms;
+  EXPECT_TRUE(pool.try_acquire());
+  EXPECT_EQ(pool.num_open(), 3);
+
+  // The idle connections above min_size are closed on the next acquire,
+  // except for the one that has been released more recently.
+  TestClock::elapsed += 700ms;
+  const auto session4 = pool.try_acquire();
+
+  EXPECT_TRUE(session4);
+  EXPECT_EQ(pool.num_open(), 1);
+}
+
+TEST(sqlite, test_connection_pool_eager) {
+  const auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                        sqlgen::ConnectionPoolConfig{.size = 3},
+                        std::string(":memory:"))
+                        .value();
+
+  // Without min_size, all connections are opened right away.
+  EXPECT_EQ(pool.num_open(), 3);
+}
+
+}  // namespace test_connection_pool_growth
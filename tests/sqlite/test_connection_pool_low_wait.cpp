@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <optional>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <thread>
+
+namespace test_connection_pool_low_wait {
+
+TEST(sqlite, test_connection_pool_low_wait) {
+  using namespace std::chrono_literals;
+  using sqlgen::Priority;
+
+  const auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                        sqlgen::ConnectionPoolConfig{.size = 2, .max_low = 1},
+                        std::string(":memory:"))
+                        .value();
+
+  auto low1 = std::make_optional(pool.try_acquire(Priority::low).value());
+  auto normal = std::make_optional(pool.try_acquire().value());
+
+  std::atomic<bool> served = false;
+
+  std::thread low2([&]() {
+    served = static_cast<bool>(pool.acquire(10s, Priority::low));
+  });
+
+  while (pool.num_waiting() < 1) {
+    std::this_thread::yield();
+  }
+
+  const auto cpu_start = std::clock();
+
+  // The pool is exhausted.
+  std::this_thread::sleep_for(100ms);
+
+  // There is a free connection now, but max_low is reached.
+  normal.reset();
+  std::this_thread::sleep_for(100ms);
+
+  const auto cpu_seconds =
+      static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+  EXPECT_FALSE(served);
+
+  low1.reset();
+  low2.join();
+
+  EXPECT_TRUE(served);
+
+#ifndef _WIN32
+  // A waiting thread sleeps, instead of spinning. std::clock() measures the
+  // wall time on Windows, so this can only be checked elsewhere.
+  EXPECT_LT(cpu_seconds, 0.01);
+#endif
+}
+
+}  // namespace test_connection_pool_low_wait
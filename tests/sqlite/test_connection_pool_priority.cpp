@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+
+namespace test_connection_pool_priority {
+
+TEST(sqlite, test_connection_pool_priority) {
+  using sqlgen::Priority;
+
+  const auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                        sqlgen::ConnectionPoolConfig{.size = 3,
+                                                     .num_reserved_for_high = 1,
+                                                     .max_low = 1},
+                        std::string(":memory:"))
+                        .value();
+
+  auto low1 = std::make_optional(pool.try_acquire(Priority::low).value());
+
+  EXPECT_FALSE(pool.try_acquire(Priority::low));
+
+  low1.reset();
+
+  const auto low2 = pool.try_acquire(Priority::low).value();
+
+  const auto normal = pool.try_acquire().value();
+
+  // The last connection is reserved for Priority::high.
+  EXPECT_FALSE(pool.try_acquire());
+
+  const auto high = pool.try_acquire(Priority::high).value();
+
+  EXPECT_FALSE(pool.try_acquire(Priority::high));
+}
+
+}  // namespace test_connection_pool_priority
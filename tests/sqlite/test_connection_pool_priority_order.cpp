@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test_connection_pool_priority_order {
+
+TEST(sqlite, test_connection_pool_priority_order) {
+  using namespace std::chrono_literals;
+  using sqlgen::Priority;
+
+  const auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                        sqlgen::ConnectionPoolConfig{.size = 1},
+                        std::string(":memory:"))
+                        .value();
+
+  const auto wait_for_waiters = [&](const size_t _n) {
+    while (pool.num_waiting() < _n) {
+      std::this_thread::yield();
+    }
+  };
+
+  auto session = std::make_optional(pool.try_acquire().value());
+
+  std::mutex mtx;
+  std::vector<std::string> served;
+
+  const auto acquire = [&](const Priority _priority, const std::string& _name) {
+    const auto s = pool.acquire(10s, _priority);
+    std::lock_guard<std::mutex> lock(mtx);
+    served.push_back(s ? _name : _name + " failed");
+  };
+
+  std::thread normal(acquire, Priority::normal, "normal");
+  wait_for_waiters(1);
+
+  std::thread high(acquire, Priority::high, "high");
+  wait_for_waiters(2);
+
+  // The thread with Priority::high arrived later, but is served first.
+  session.reset();
+
+  normal.join();
+  high.join();
+
+  EXPECT_EQ(served, (std::vector<std::string>{"high", "normal"}));
+}
+
+}  // namespace test_connection_pool_priority_order
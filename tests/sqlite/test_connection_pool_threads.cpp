@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace test_connection_pool_threads {
+
+TEST(sqlite, test_connection_pool_threads) {
+  using namespace std::chrono_literals;
+
+  const auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                        sqlgen::ConnectionPoolConfig{.size = 4,
+                                                     .min_size = 4,
+                                                     .num_shards = 4},
+                        std::string(":memory:"))
+                        .value();
+
+  std::atomic<size_t> num_failed = 0;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < 200; ++j) {
+        const auto session = pool.acquire(10s);
+        if (!session || !(*session)->execute("SELECT 1;")) {
+          ++num_failed;
+        }
+      }
+    });
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(num_failed, 0);
+  EXPECT_EQ(pool.num_open(), 4);
+  EXPECT_EQ(pool.available(), 4);
+}
+
+}  // namespace test_connection_pool_threads
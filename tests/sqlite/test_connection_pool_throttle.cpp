@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+
+namespace test_connection_pool_throttle {
+
+TEST(sqlite, test_connection_pool_throttle) {
+  using namespace std::chrono_literals;
+  using sqlgen::Priority;
+
+  const auto pool = sqlgen::make_connection_pool<sqlgen::sqlite::Connection>(
+                        sqlgen::ConnectionPoolConfig{
+                            .size = 4,
+                            .low_rate_per_second = 10.0,
+                            .low_burst = 1},
+                        std::string(":memory:"))
+                        .value();
+
+  const auto low1 = pool.try_acquire(Priority::low).value();
+
+  // There are free connections, but the token bucket is empty.
+  EXPECT_FALSE(pool.try_acquire(Priority::low));
+
+  // Only Priority::low is throttled.
+  EXPECT_TRUE(pool.try_acquire());
+
+  // The next token is ready after 100ms, which wakes up the waiting thread.
+  const auto start = std::chrono::steady_clock::now();
+  const auto low2 = pool.acquire(5s, Priority::low);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_TRUE(low2);
+  EXPECT_GE(elapsed, 50ms);
+  EXPECT_LT(elapsed, 1s);
+}
+
+}  // namespace test_connection_pool_throttle
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_insert_after_error {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(sqlite, test_insert_after_error) {
+  const auto homer =
+      Person{.id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45};
+
+  const auto bart =
+      Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10};
+
+  const auto lisa =
+      Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8};
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn =
+      sqlite::connect().and_then(create_table<Person> | if_not_exists).value();
+
+  EXPECT_TRUE(insert(conn, homer));
+
+  // The duplicate primary key must not break the cached statement.
+  EXPECT_FALSE(insert(conn, homer));
+  EXPECT_TRUE(insert(conn, bart));
+
+  // The same holds for the statement used by write(...).
+  EXPECT_FALSE(write(conn, std::vector<Person>({homer})));
+  EXPECT_TRUE(write(conn, std::vector<Person>({lisa})));
+
+  const auto people =
+      (sqlgen::read<std::vector<Person>> | order_by("id"_c))(conn).value();
+
+  EXPECT_EQ(rfl::json::write(people),
+            rfl::json::write(std::vector<Person>({homer, bart, lisa})));
+}
+
+}  // namespace test_insert_after_error
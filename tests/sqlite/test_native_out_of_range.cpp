@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_native_out_of_range {
+
+struct Wide {
+  static constexpr const char* tablename = "NATIVE_VALUES";
+
+  int64_t number;
+  double fraction;
+};
+
+struct Narrow {
+  static constexpr const char* tablename = "NATIVE_VALUES";
+
+  int8_t number;
+  int fraction;
+};
+
+TEST(sqlite, test_native_out_of_range) {
+  using namespace sqlgen;
+
+  const auto in_range =
+      std::vector<Wide>({Wide{.number = -128, .fraction = 3.7}});
+
+  const auto conn1 = sqlite::connect()
+                         .and_then(create_table<Wide>)
+                         .and_then(insert(in_range));
+
+  const auto narrow = sqlgen::read<std::vector<Narrow>>(conn1).value();
+
+  ASSERT_EQ(narrow.size(), 1);
+  EXPECT_EQ(narrow.at(0).number, -128);
+  EXPECT_EQ(narrow.at(0).fraction, 3);
+
+  // 300 does not fit into an int8_t.
+  const auto conn2 =
+      sqlite::connect()
+          .and_then(create_table<Wide>)
+          .and_then(insert(
+              std::vector<Wide>({Wide{.number = 300, .fraction = 0.0}})));
+
+  EXPECT_FALSE(sqlgen::read<std::vector<Narrow>>(conn2));
+
+  // 1e20 does not fit into an int.
+  const auto conn3 = sqlite::connect()
+                         .and_then(create_table<Wide>)
+                         .and_then(insert(std::vector<Wide>(
+                             {Wide{.number = 0, .fraction = 1e20}})));
+
+  EXPECT_FALSE(sqlgen::read<std::vector<Narrow>>(conn3));
+}
+
+}  // namespace test_native_out_of_range
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_native_types {
+
+struct Measurement {
+  sqlgen::PrimaryKey<int64_t> id;
+  int8_t small;
+  uint32_t count;
+  double value;
+  float ratio;
+  bool valid;
+  std::optional<int> maybe;
+  std::string label;
+};
+
+TEST(sqlite, test_native_types) {
+  const auto measurements1 = std::vector<Measurement>(
+      {Measurement{.id = -1,
+                   .small = -8,
+                   .count = 4000000000,
+                   .value = 0.1,
+                   .ratio = 0.5f,
+                   .valid = true,
+                   .maybe = 42,
+                   .label = "a"},
+       Measurement{.id = 9007199254740993,
+                   .small = 127,
+                   .count = 0,
+                   .value = -1.0e300,
+                   .ratio = -2.25f,
+                   .valid = false,
+                   .maybe = std::nullopt,
+                   .label = "12"}});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto measurements2 =
+      sqlite::connect()
+          .and_then(create_table<Measurement> | if_not_exists)
+          .and_then(insert(measurements1))
+          .and_then(sqlgen::read<std::vector<Measurement>> |
+                    order_by("id"_c))
+          .value();
+
+  const auto json1 = rfl::json::write(measurements1);
+  const auto json2 = rfl::json::write(measurements2);
+
+  EXPECT_EQ(json1, json2);
+}
+
+}  // namespace test_native_types
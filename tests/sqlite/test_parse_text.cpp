@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_parse_text {
+
+enum class Color { red, green, blue };
+
+struct RawValues {
+  static constexpr const char* tablename = "VALUES_AS_TEXT";
+
+  std::string flag;
+  std::string number;
+  std::string fraction;
+  std::string color;
+};
+
+struct Values {
+  static constexpr const char* tablename = "VALUES_AS_TEXT";
+
+  bool flag;
+  int number;
+  double fraction;
+  Color color;
+};
+
+struct SmallValues {
+  static constexpr const char* tablename = "VALUES_AS_TEXT";
+
+  bool flag;
+  int8_t number;
+  double fraction;
+  Color color;
+};
+
+TEST(sqlite, test_parse_text) {
+  const auto raw = std::vector<RawValues>(
+      {RawValues{
+           .flag = "t", .number = " 42", .fraction = "0.5", .color = "red"},
+       RawValues{.flag = "false",
+                 .number = "+1000",
+                 .fraction = "-1e3",
+                 .color = "blue"}});
+
+  using namespace sqlgen;
+
+  const auto conn = sqlite::connect()
+                        .and_then(create_table<RawValues>)
+                        .and_then(insert(raw));
+
+  const auto values = sqlgen::read<std::vector<Values>>(conn).value();
+
+  ASSERT_EQ(values.size(), 2);
+  EXPECT_TRUE(values.at(0).flag);
+  EXPECT_EQ(values.at(0).number, 42);
+  EXPECT_EQ(values.at(0).fraction, 0.5);
+  EXPECT_EQ(values.at(0).color, Color::red);
+  EXPECT_FALSE(values.at(1).flag);
+  EXPECT_EQ(values.at(1).number, 1000);
+  EXPECT_EQ(values.at(1).fraction, -1000.0);
+  EXPECT_EQ(values.at(1).color, Color::blue);
+
+  // 1000 does not fit into an int8_t.
+  const auto small_values = sqlgen::read<std::vector<SmallValues>>(conn);
+
+  EXPECT_FALSE(small_values);
+}
+
+}  // namespace test_parse_text
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_parse_timestamps {
+
+struct RawValues {
+  static constexpr const char* tablename = "TIMESTAMPS_AS_TEXT";
+
+  std::string date;
+  std::string date_time;
+  std::string iso;
+};
+
+struct Values {
+  static constexpr const char* tablename = "TIMESTAMPS_AS_TEXT";
+
+  sqlgen::Date date;
+  sqlgen::DateTime date_time;
+  sqlgen::Timestamp<"%Y-%m-%dT%H:%M:%S%z"> iso;
+};
+
+TEST(sqlite, test_parse_timestamps) {
+  const auto raw = std::vector<RawValues>(
+      {RawValues{.date = "2024-02-29",
+                 .date_time = "1989-12-17 12:00:00",
+                 .iso = "2024-03-01T08:15:30Z"},
+       RawValues{.date = "1970-01-01",
+                 .date_time = "2000-01-01 23:59:59.123456",
+                 .iso = "2024-03-01T08:15:30.25-05:30"}});
+
+  using namespace sqlgen;
+
+  const auto conn = sqlite::connect()
+                        .and_then(create_table<RawValues>)
+                        .and_then(insert(raw));
+
+  const auto values = sqlgen::read<std::vector<Values>>(conn).value();
+
+  ASSERT_EQ(values.size(), 2);
+
+  EXPECT_EQ(values.at(0).date.str(), "2024-02-29");
+  EXPECT_EQ(values.at(0).date.tm().tm_wday, 4);
+  EXPECT_EQ(values.at(0).date.tm().tm_yday, 59);
+  EXPECT_EQ(values.at(0).date_time.str(), "1989-12-17 12:00:00");
+  EXPECT_EQ(values.at(0).iso.str(), "2024-03-01T08:15:30+0000");
+
+  EXPECT_EQ(values.at(1).date.str(), "1970-01-01");
+  EXPECT_EQ(values.at(1).date_time.str(), "2000-01-01 23:59:59");
+  EXPECT_EQ(values.at(1).iso.str(), "2024-03-01T08:15:30-0530");
+
+  // Writing the values must produce the same text as strftime.
+  const auto conn2 =
+      sqlite::connect().and_then(write(std::ref(values))).value();
+
+  const auto raw2 = sqlgen::read<std::vector<RawValues>>(conn2).value();
+
+  ASSERT_EQ(raw2.size(), 2);
+  EXPECT_EQ(raw2.at(0).date, "2024-02-29");
+  EXPECT_EQ(raw2.at(1).date_time, "2000-01-01 23:59:59");
+  EXPECT_EQ(raw2.at(1).iso, "2024-03-01T08:15:30-0530");
+}
+
+}  // namespace test_parse_timestamps
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_prefetch {
+
+struct Measurement {
+  sqlgen::PrimaryKey<int64_t> id;
+  double value;
+};
+
+TEST(sqlite, test_prefetch) {
+  // Spans several batches, the last of which is incomplete.
+  const int64_t num_rows = 2 * SQLGEN_BATCH_SIZE + 17;
+
+  auto measurements = std::vector<Measurement>();
+  for (int64_t i = 0; i < num_rows; ++i) {
+    measurements.push_back(
+        Measurement{.id = i, .value = static_cast<double>(i) * 0.5});
+  }
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlite::connect().and_then(write(std::ref(measurements)));
+
+  const auto query = read<Range<Measurement>> | prefetch(2);
+
+  const auto range = query(conn).value();
+
+  int64_t expected = 0;
+  for (const auto& res : range) {
+    ASSERT_TRUE(res);
+    EXPECT_EQ(res->id(), expected);
+    EXPECT_EQ(res->value, static_cast<double>(expected) * 0.5);
+    ++expected;
+  }
+  EXPECT_EQ(expected, num_rows);
+
+  const auto query2 =
+      read<std::vector<Measurement>> | where("id"_c >= 10) | prefetch();
+
+  const auto vec = query2(conn).value();
+
+  ASSERT_EQ(vec.size(), static_cast<size_t>(num_rows - 10));
+  EXPECT_EQ(vec.front().id(), 10);
+  EXPECT_EQ(vec.back().id(), num_rows - 1);
+}
+
+}  // namespace test_prefetch
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_prepare {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+struct ByAge {
+  int min_age;
+  int max_age;
+};
+
+struct Rename {
+  uint32_t id;
+  std::string first_name;
+};
+
+TEST(sqlite, test_prepare) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{.id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10},
+       Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0},
+       Person{
+           .id = 4, .first_name = "Hugo", .last_name = "Simpson", .age = 10}});
+
+  const auto conn = sqlgen::sqlite::connect();
+
+  sqlgen::write(conn, people1);
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto by_age = prepare<ByAge>(
+      read<std::vector<Person>> |
+      where("age"_c >= param<"min_age">() && "age"_c <= param<"max_age">()) |
+      order_by("id"_c));
+
+  const auto children = by_age(conn, {.min_age = 1, .max_age = 17}).value();
+
+  const auto adults = by_age(conn, {.min_age = 18, .max_age = 99}).value();
+
+  const auto rename = prepare<Rename>(
+      update<Person>("first_name"_c.set(param<"first_name">())) |
+      where("id"_c == param<"id">()));
+
+  rename(conn, {.id = 4, .first_name = "Bert"}).value();
+
+  const auto by_id = prepare<Rename>(read<Person> |
+                                     where("id"_c == param<"id">()));
+
+  const auto bert = by_id(conn, {.id = 4}).value();
+
+  const std::string expected_children =
+      R"([{"id":1,"first_name":"Bart","last_name":"Simpson","age":10},{"id":2,"first_name":"Lisa","last_name":"Simpson","age":8},{"id":4,"first_name":"Hugo","last_name":"Simpson","age":10}])";
+
+  const std::string expected_adults =
+      R"([{"id":0,"first_name":"Homer","last_name":"Simpson","age":45}])";
+
+  EXPECT_EQ(rfl::json::write(children), expected_children);
+  EXPECT_EQ(rfl::json::write(adults), expected_adults);
+  EXPECT_EQ(bert.first_name, "Bert");
+}
+
+}  // namespace test_prepare
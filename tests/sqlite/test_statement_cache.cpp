@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_statement_cache {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(sqlite, test_statement_cache) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{
+           .id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10}});
+
+  const auto people2 = std::vector<Person>(
+      {Person{.id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8},
+       Person{
+           .id = 3, .first_name = "Maggie", .last_name = "Simpson", .age = 0}});
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto conn = sqlite::connect()
+                        .and_then(create_table<Person> | if_not_exists)
+                        .and_then(insert(people1))
+                        .and_then(insert(people2));
+
+  const auto query = sqlgen::read<std::vector<Person>> | order_by("id"_c);
+
+  const auto people3 = query(conn).value();
+  const auto people4 = query(conn).value();
+
+  const auto stats = conn.value()->statement_cache_stats();
+
+  EXPECT_EQ(stats.capacity, 100);
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.size, 2);
+
+  auto people5 = people1;
+  people5.insert(people5.end(), people2.begin(), people2.end());
+
+  EXPECT_EQ(rfl::json::write(people3), rfl::json::write(people5));
+  EXPECT_EQ(rfl::json::write(people4), rfl::json::write(people5));
+
+  // Two ranges over the same query must not share a statement.
+  const auto range_query =
+      sqlgen::read<sqlgen::Range<Person>> | order_by("id"_c);
+
+  const auto range1 = range_query(conn).value();
+  const auto range2 = range_query(conn).value();
+
+  auto it1 = range1.begin();
+  auto it2 = range2.begin();
+
+  for (const auto& person : people5) {
+    ASSERT_TRUE(it1 != range1.end());
+    ASSERT_TRUE(it2 != range2.end());
+    EXPECT_EQ((*it1).value().id.value(), person.id.value());
+    EXPECT_EQ((*it2).value().id.value(), person.id.value());
+    ++it1;
+    ++it2;
+  }
+}
+
+}  // namespace test_statement_cache
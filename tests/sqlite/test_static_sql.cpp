@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <rfl/json.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <vector>
+
+namespace test_static_sql {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+TEST(sqlite, test_static_sql) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{
+           .id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10}});
+
+  const auto people2 = std::vector<Person>(
+      {Person{
+          .id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8}});
+
+  const auto conn1 = sqlgen::sqlite::connect();
+  const auto conn2 = sqlgen::sqlite::connect();
+
+  sqlgen::write(conn1, people1);
+  sqlgen::write(conn2, people2);
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  const auto query = read<std::vector<Person>> | order_by("id"_c);
+
+  // The SQL is generated once, but every read must still go to the
+  // connection it was called on.
+  const auto people3 = query(conn1).value();
+  const auto people4 = query(conn2).value();
+  const auto people5 = query(conn1).value();
+
+  EXPECT_EQ(rfl::json::write(people1), rfl::json::write(people3));
+  EXPECT_EQ(rfl::json::write(people2), rfl::json::write(people4));
+  EXPECT_EQ(rfl::json::write(people1), rfl::json::write(people5));
+}
+
+}  // namespace test_static_sql
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <rfl.hpp>
+#include <sqlgen.hpp>
+#include <sqlgen/sqlite.hpp>
+#include <string>
+#include <vector>
+
+namespace test_static_sql_count {
+
+struct Person {
+  sqlgen::PrimaryKey<uint32_t> id;
+  std::string first_name;
+  std::string last_name;
+  int age;
+};
+
+/// Forwards everything to an SQLite connection, counting how often the SQL
+/// is generated.
+class CountingConnection {
+ public:
+  CountingConnection() : conn_(sqlgen::sqlite::connect().value()) {}
+
+  sqlgen::Result<sqlgen::Nothing> begin_transaction() {
+    return conn_->begin_transaction();
+  }
+
+  sqlgen::Result<sqlgen::Nothing> commit() { return conn_->commit(); }
+
+  sqlgen::Result<sqlgen::Nothing> execute(const std::string& _sql) {
+    return conn_->execute(_sql);
+  }
+
+  sqlgen::Result<sqlgen::Nothing> execute(const std::string& _sql,
+                                          const sqlgen::RowBatch& _params) {
+    return conn_->execute(_sql, _params);
+  }
+
+  sqlgen::Result<sqlgen::Nothing> insert(const sqlgen::dynamic::Insert& _stmt,
+                                         const sqlgen::RowBatch& _data) {
+    return conn_->insert(_stmt, _data);
+  }
+
+  size_t num_to_sql() const { return num_to_sql_; }
+
+  sqlgen::Result<sqlgen::Ref<sqlgen::IteratorBase>> read(
+      const sqlgen::dynamic::SelectFrom& _query) {
+    return conn_->read(_query);
+  }
+
+  sqlgen::Result<sqlgen::Ref<sqlgen::IteratorBase>> read(
+      const std::string& _sql, const sqlgen::RowBatch& _params) {
+    return conn_->read(_sql, _params);
+  }
+
+  sqlgen::Result<sqlgen::Nothing> rollback() { return conn_->rollback(); }
+
+  std::string to_sql(const sqlgen::dynamic::Statement& _stmt) {
+    ++num_to_sql_;
+    return conn_->to_sql(_stmt);
+  }
+
+  sqlgen::Result<sqlgen::Nothing> start_write(
+      const sqlgen::dynamic::Write& _stmt) {
+    return conn_->start_write(_stmt);
+  }
+
+  sqlgen::Result<sqlgen::Nothing> end_write() { return conn_->end_write(); }
+
+  sqlgen::Result<sqlgen::Nothing> write(const sqlgen::RowBatch& _data) {
+    return conn_->write(_data);
+  }
+
+ private:
+  sqlgen::Ref<sqlgen::sqlite::Connection> conn_;
+
+  size_t num_to_sql_ = 0;
+};
+
+static_assert(sqlgen::is_connection<CountingConnection>,
+              "Must fulfill the is_connection concept.");
+
+TEST(sqlite, test_static_sql_count) {
+  const auto people1 = std::vector<Person>(
+      {Person{
+           .id = 0, .first_name = "Homer", .last_name = "Simpson", .age = 45},
+       Person{
+           .id = 1, .first_name = "Bart", .last_name = "Simpson", .age = 10}});
+
+  const auto people2 = std::vector<Person>(
+      {Person{
+          .id = 2, .first_name = "Lisa", .last_name = "Simpson", .age = 8}});
+
+  const auto conn = sqlgen::Ref<CountingConnection>::make();
+
+  using namespace sqlgen;
+  using namespace sqlgen::literals;
+
+  write(conn, people1).value();
+  write(conn, people2).value();
+
+  // The CREATE TABLE statement is only generated by the first write.
+  EXPECT_EQ(conn->num_to_sql(), 1);
+
+  const auto query = read<std::vector<Person>> | order_by("id"_c);
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(query(conn).value().size(), 3);
+  }
+
+  EXPECT_EQ(conn->num_to_sql(), 2);
+
+  delete_from<Person>(conn).value();
+  delete_from<Person>(conn).value();
+
+  EXPECT_EQ(conn->num_to_sql(), 3);
+  EXPECT_EQ(query(conn).value().size(), 0);
+  EXPECT_EQ(conn->num_to_sql(), 3);
+}
+
+}  // namespace test_static_sql_count